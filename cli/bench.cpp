@@ -0,0 +1,470 @@
+// pkhouse-bench - throughput benchmarks for the save/bank core on a host PC.
+// Builds synthetic saves and banks for every format in a temp directory,
+// times the hot paths and prints the results as JSON, so runs from
+// different releases can be diffed.
+//
+//   pkhouse-bench [--filter <substr>] [--min-time <seconds>] [-o <file>]
+
+#include "save_file.h"
+#include "bank.h"
+#include "poke_crypto.h"
+#include "sc_block.h"
+#include "swish_crypto.h"
+#include "species_converter.h"
+#include "task_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#ifndef PKHOUSE_DATA_DIR
+#define PKHOUSE_DATA_DIR "romfs/data/"
+#endif
+
+namespace {
+
+struct Result {
+    std::string name;
+    int    iterations;
+    size_t bytes;          // bytes processed per iteration (0 = n/a)
+    double minNs;
+    double medianNs;
+    double meanNs;
+};
+
+struct Options {
+    std::string filter;
+    double minTime = 0.5;  // seconds of timed work per benchmark
+    std::string outPath;
+};
+
+Options opts;
+std::vector<Result> results;
+std::mt19937 rng(0x504B48);
+
+// Time run() until at least opts.minTime seconds (and 5 iterations) have
+// been spent in it. setup() runs before each iteration, outside the timer.
+template <typename Setup, typename Run>
+void bench(const std::string& name, size_t bytes, Setup setup, Run run) {
+    if (!opts.filter.empty() && name.find(opts.filter) == std::string::npos)
+        return;
+
+    using clock = std::chrono::steady_clock;
+    std::vector<double> samples;
+    double total = 0;
+    while ((total < opts.minTime * 1e9 || samples.size() < 5) && samples.size() < 100000) {
+        setup();
+        auto t0 = clock::now();
+        run();
+        auto t1 = clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        samples.push_back(ns);
+        total += ns;
+    }
+
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    Result r;
+    r.name = name;
+    r.iterations = static_cast<int>(samples.size());
+    r.bytes = bytes;
+    r.minNs = sorted.front();
+    r.medianNs = sorted[sorted.size() / 2];
+    r.meanNs = total / samples.size();
+    results.push_back(r);
+    std::fprintf(stderr, "%-36s %8d it  %12.0f ns median\n", name.c_str(), r.iterations, r.medianNs);
+}
+
+void noSetup() {}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)),
+                                std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return;
+    std::fwrite(data.data(), 1, data.size(), f);
+    std::fclose(f);
+}
+
+// Random but well-formed enough Pokemon: valid species, non-zero EC
+Pokemon randomPokemon(GameType game) {
+    Pokemon pkm;
+    pkm.gameType_ = game;
+    for (auto& b : pkm.data)
+        b = static_cast<uint8_t>(rng());
+    pkm.writeU32(0x00, rng() | 1);
+    pkm.writeU16(pkm.ofs().speciesInternal, static_cast<uint16_t>(1 + rng() % 386));
+    return pkm;
+}
+
+// --- Synthetic containers ---
+// Empty images of each save format, filled to two thirds through
+// SaveFile::setBoxSlots so the slot data is produced by the real code.
+
+std::vector<uint8_t> emptySCBlockSave(GameType game) {
+    const GameInfo& info = gameInfo(game);
+    uint32_t kbox = game == GameType::LA ? 0x47E1CEAB : 0x0d66012c;
+    uint32_t kstatus = (isSV(game) || game == GameType::ZA) ? 0xE3E89BD1 : 0xf25c070e;
+
+    // Payload storage must outlive the blocks (they hold views)
+    std::vector<std::vector<uint8_t>> payloads;
+    payloads.reserve(4000);
+    std::vector<SCBlock> blocks;
+    auto add = [&](uint32_t key, SCTypeCode type, size_t size, bool random) {
+        payloads.emplace_back(size, 0);
+        if (random)
+            for (auto& b : payloads.back()) b = static_cast<uint8_t>(rng());
+        SCBlock blk{};
+        blk.key = key;
+        blk.type = type;
+        blk.data.setView(payloads.back().data(), size);
+        blocks.push_back(std::move(blk));
+    };
+
+    add(kbox, SCTypeCode::Object, (size_t)info.saveSlotSize * info.boxCount * info.slotsPerBox, false);
+    add(0x19722c89, SCTypeCode::Object, 0x22 * info.boxCount, false);
+    add(kstatus, SCTypeCode::Object, 0x100, true);
+    // Filler roughly shaped like a real save: a few thousand small blocks
+    for (int i = 0; i < 3000; i++) {
+        if (rng() % 4 == 0) {
+            SCBlock blk{};
+            blk.key = rng();
+            blk.type = SCTypeCode::Bool2;
+            blocks.push_back(std::move(blk));
+        } else {
+            add(rng(), SCTypeCode::Object, rng() % 800, true);
+        }
+    }
+    return SwishCrypto::encrypt(blocks);
+}
+
+std::vector<uint8_t> emptyBDSPSave() {
+    return std::vector<uint8_t>(0xEF0A4, 0); // v1.3 size
+}
+
+std::vector<uint8_t> emptyLGPESave() {
+    std::vector<uint8_t> data(0x100000, 0);
+    for (int i = 0; i < 6; i++) // PokeListHeader: no party members
+        std::memcpy(data.data() + 0x5A00 + i * 2, &SaveFile::LGPE_SLOT_EMPTY, 2);
+    return data;
+}
+
+std::vector<uint8_t> emptyGBASave() {
+    std::vector<uint8_t> data(0x20000, 0);
+    for (int slot = 0; slot < 2; slot++) {
+        for (uint16_t id = 0; id < 14; id++) {
+            uint8_t* sector = data.data() + (slot * 14 + id) * 0x1000;
+            uint32_t counter = slot == 0 ? 2 : 1;
+            std::memcpy(sector + 0xFF4, &id, 2);
+            std::memcpy(sector + 0xFFC, &counter, 4);
+        }
+    }
+    return data;
+}
+
+void fillSave(const std::string& path, GameType game) {
+    SaveFile save;
+    save.setGameType(game);
+    if (!save.load(path))
+        return;
+    std::vector<SaveFile::BoxSlotWrite> writes;
+    int total = save.boxCount() * save.slotsPerBox();
+    for (int i = 0; i < total; i++) {
+        if (i % 3 == 2)
+            continue;
+        writes.push_back({i / save.slotsPerBox(), i % save.slotsPerBox(), randomPokemon(game)});
+    }
+    save.setBoxSlots(writes);
+    save.save(path);
+}
+
+void fillBank(const std::string& path, GameType game) {
+    Bank bank;
+    bank.setGameType(game);
+    for (int i = 0; i < bank.totalSlots(); i++) {
+        if (i % 3 != 2)
+            bank.setSlot(i / bank.slotsPerBox(), i % bank.slotsPerBox(), randomPokemon(game));
+    }
+    bank.save(path);
+}
+
+struct SaveFormat {
+    const char* name;
+    GameType game;
+    std::vector<uint8_t> (*make)();
+};
+
+// --- Benchmarks ---
+
+void benchXorShift() {
+    // SCBlock payload keystream: word-batched xorBytes against next() per byte
+    std::vector<uint8_t> buf(1 << 20);
+    for (auto& b : buf)
+        b = static_cast<uint8_t>(rng());
+    uint32_t seed = 0;
+    bench("scxorshift/xorBytes", buf.size(), noSetup, [&] {
+        SCXorShift32 xs(seed++);
+        xs.xorBytes(buf.data(), buf.data(), buf.size());
+    });
+    bench("scxorshift/nextPerByte", buf.size(), noSetup, [&] {
+        SCXorShift32 xs(seed++);
+        for (auto& b : buf)
+            b ^= xs.next();
+    });
+}
+
+void benchSwishCrypto(const std::string& dir) {
+    for (GameType game : {GameType::S, GameType::ZA}) {
+        std::string tag = gameInfo(game).gameTag;
+        std::string path = dir + "/swish_" + tag;
+        writeFile(path, emptySCBlockSave(game));
+        fillSave(path, game);
+        const std::vector<uint8_t> image = readFile(path);
+
+        std::vector<uint8_t> work;
+        std::vector<SCBlock> blocks;
+        bench("swish/decrypt/" + tag, image.size(),
+              [&] { work = image; },
+              [&] { SwishCrypto::decrypt(work.data(), work.size(), blocks); });
+
+        std::vector<uint8_t> arena = image;
+        SwishCrypto::decrypt(arena.data(), arena.size(), blocks);
+        bench("swish/encrypt/" + tag, image.size(), noSetup,
+              [&] { SwishCrypto::encrypt(blocks); });
+    }
+}
+
+void benchPokeCrypto() {
+    struct Format {
+        const char* name;
+        GameType game;
+        int size;
+        void (*decrypt)(const uint8_t*, size_t, uint8_t*);
+        void (*encrypt)(const uint8_t*, size_t, uint8_t*);
+    };
+    const Format formats[] = {
+        {"9",  GameType::ZA, PokeCrypto::SIZE_9PARTY,   PokeCrypto::decryptArray9,  PokeCrypto::encryptArray9},
+        {"8A", GameType::LA, PokeCrypto::SIZE_8ASTORED, PokeCrypto::decryptArray8A, PokeCrypto::encryptArray8A},
+        {"6",  GameType::GP, PokeCrypto::SIZE_6PARTY,   PokeCrypto::decryptArray6,  PokeCrypto::encryptArray6},
+        {"3",  GameType::FR, PokeCrypto::SIZE_3STORED,  PokeCrypto::decryptArray3,  PokeCrypto::encryptArray3},
+    };
+
+    // One iteration = a full 960-slot container
+    constexpr int COUNT = 960;
+
+    // Keystream alone: vector path against the serial reference
+    {
+        constexpr size_t LEN = PokeCrypto::BLOCK_COUNT * PokeCrypto::BLOCK_SIZE;
+        std::vector<uint8_t> buf((size_t)COUNT * LEN);
+        for (auto& b : buf)
+            b = static_cast<uint8_t>(rng());
+        bench("pokecrypto/cryptArray", buf.size(), noSetup, [&] {
+            for (int i = 0; i < COUNT; i++)
+                PokeCrypto::cryptArray(buf.data() + (size_t)i * LEN, LEN, i);
+        });
+        bench("pokecrypto/cryptArrayScalar", buf.size(), noSetup, [&] {
+            for (int i = 0; i < COUNT; i++)
+                PokeCrypto::cryptArrayScalar(buf.data() + (size_t)i * LEN, LEN, i);
+        });
+    }
+
+    for (const auto& f : formats) {
+        std::vector<uint8_t> plain((size_t)COUNT * f.size), enc(plain.size()), out(plain.size());
+        for (int i = 0; i < COUNT; i++) {
+            Pokemon pkm = randomPokemon(f.game);
+            std::memcpy(plain.data() + (size_t)i * f.size, pkm.data.data(), f.size);
+        }
+        for (int i = 0; i < COUNT; i++)
+            f.encrypt(plain.data() + (size_t)i * f.size, f.size, enc.data() + (size_t)i * f.size);
+
+        bench(std::string("pokecrypto/decrypt") + f.name, enc.size(), noSetup, [&] {
+            for (int i = 0; i < COUNT; i++)
+                f.decrypt(enc.data() + (size_t)i * f.size, f.size, out.data() + (size_t)i * f.size);
+        });
+        bench(std::string("pokecrypto/encrypt") + f.name, plain.size(), noSetup, [&] {
+            for (int i = 0; i < COUNT; i++)
+                f.encrypt(plain.data() + (size_t)i * f.size, f.size, out.data() + (size_t)i * f.size);
+        });
+    }
+}
+
+void benchSaveFile(const std::string& dir) {
+    const SaveFormat formats[] = {
+        {"scblock", GameType::ZA, [] { return emptySCBlockSave(GameType::ZA); }},
+        {"bdsp",    GameType::BD, emptyBDSPSave},
+        {"lgpe",    GameType::GP, emptyLGPESave},
+        {"gba",     GameType::FR, emptyGBASave},
+    };
+
+    for (const auto& f : formats) {
+        std::string path = dir + "/save_" + f.name;
+        writeFile(path, f.make());
+        fillSave(path, f.game);
+        size_t size = readFile(path).size();
+        std::string prefix = std::string("save/") + f.name;
+
+        bench(prefix + "/load", size, noSetup, [&] {
+            SaveFile save;
+            save.setGameType(f.game);
+            save.load(path);
+        });
+
+        // Saving after one slot changed: the common case in the app
+        SaveFile save;
+        save.setGameType(f.game);
+        save.load(path);
+        int n = 0;
+        bench(prefix + "/save", size,
+              [&] { save.setBoxSlot(0, n++ % save.slotsPerBox(), randomPokemon(f.game)); },
+              [&] { save.save(path); });
+
+        // Read every slot of a freshly loaded save (decrypt all boxes)
+        SaveFile fresh;
+        bench(prefix + "/read_all", size,
+              [&] { fresh.setGameType(f.game); fresh.load(path); },
+              [&] {
+                  for (int b = 0; b < fresh.boxCount(); b++)
+                      for (int s = 0; s < fresh.slotsPerBox(); s++)
+                          fresh.getBoxSlot(b, s);
+              });
+    }
+}
+
+void benchBank(const std::string& dir) {
+    for (GameType game : {GameType::ZA, GameType::FR}) {
+        std::string tag = gameInfo(game).gameTag;
+        std::string path = dir + "/bank_" + tag + ".bin";
+        fillBank(path, game);
+        size_t size = readFile(path).size();
+        std::string prefix = "bank/" + tag;
+
+        // load() only reads the header; reading every slot pulls in all boxes
+        bench(prefix + "/load_read_all", size, noSetup, [&] {
+            Bank bank;
+            bank.setGameType(game);
+            bank.load(path);
+            bank.setGameType(game);
+            for (int b = 0; b < bank.boxCount(); b++)
+                for (int s = 0; s < bank.slotsPerBox(); s++)
+                    bank.getSlot(b, s);
+        });
+
+        Bank bank;
+        bank.setGameType(game);
+        bank.load(path);
+        bank.setGameType(game);
+        int n = 0;
+        bench(prefix + "/save_partial", size,
+              [&] { bank.setSlot(0, n++ % bank.slotsPerBox(), randomPokemon(game)); },
+              [&] { bank.save(path); });
+
+        std::string copy = dir + "/bank_" + tag + "_copy.bin";
+        bench(prefix + "/save_full", size,
+              [&] { std::remove(copy.c_str()); },
+              [&] { bank.save(copy); });
+    }
+}
+
+void benchSearch(const std::string& dir) {
+    // SV: 32 boxes x 30 slots, the 960-slot full-save search case
+    std::string path = dir + "/search_main";
+    writeFile(path, emptySCBlockSave(GameType::S));
+    fillSave(path, GameType::S);
+
+    SearchQuery query;
+    query.speciesName = "a";
+    query.levelMin = 20;
+    query.minPerfectIVs = 1;
+
+    SaveFile save;
+    bench("search/save/build", 0,
+          [&] { save.setGameType(GameType::S); save.load(path); },
+          [&] { save.searchIndex(); });
+
+    std::vector<int> hits;
+    bench("search/save/scan", 0, [&] { hits.clear(); },
+          [&] { save.searchIndex().scan(query, hits); });
+
+    std::string bankPath = dir + "/search_bank.bin";
+    fillBank(bankPath, GameType::ZA);
+    Bank bank;
+    bench("search/bank/build", 0,
+          [&] { bank.setGameType(GameType::ZA); bank.load(bankPath); bank.setGameType(GameType::ZA); },
+          [&] { bank.searchIndex(); });
+    bench("search/bank/scan", 0, [&] { hits.clear(); },
+          [&] { bank.searchIndex().scan(query, hits); });
+}
+
+void printJson(FILE* out) {
+    std::fprintf(out, "{\n  \"threads\": %d,\n  \"benchmarks\": [\n", TaskPool::shared().concurrency());
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        double mbps = r.bytes ? (r.bytes / 1e6) / (r.medianNs / 1e9) : 0;
+        std::fprintf(out,
+            "    {\"name\": \"%s\", \"iterations\": %d, \"bytes\": %zu, "
+            "\"min_ns\": %.0f, \"median_ns\": %.0f, \"mean_ns\": %.0f, \"mb_per_s\": %.1f}%s\n",
+            r.name.c_str(), r.iterations, r.bytes, r.minNs, r.medianNs, r.meanNs, mbps,
+            i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            opts.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+            opts.minTime = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            opts.outPath = argv[++i];
+        else {
+            std::fprintf(stderr, "usage: pkhouse-bench [--filter <substr>] [--min-time <seconds>] [-o <file>]\n");
+            return 2;
+        }
+    }
+
+    std::string dataDir = PKHOUSE_DATA_DIR;
+    if (const char* env = std::getenv("PKHOUSE_DATA"))
+        dataDir = std::string(env) + "/";
+    SpeciesName::load(dataDir + "species_en.txt");
+
+    char tmpl[] = "/tmp/pkhouse-bench-XXXXXX";
+    if (!mkdtemp(tmpl)) {
+        std::fprintf(stderr, "error: cannot create a temp directory\n");
+        return 1;
+    }
+    std::string dir = tmpl;
+
+    benchXorShift();
+    benchSwishCrypto(dir);
+    benchPokeCrypto();
+    benchSaveFile(dir);
+    benchBank(dir);
+    benchSearch(dir);
+
+    std::string cleanup = "rm -rf '" + dir + "'";
+    std::system(cleanup.c_str());
+
+    FILE* out = opts.outPath.empty() ? stdout : std::fopen(opts.outPath.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "error: cannot write %s\n", opts.outPath.c_str());
+        return 1;
+    }
+    printJson(out);
+    if (out != stdout)
+        std::fclose(out);
+    return 0;
+}
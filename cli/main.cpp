@@ -0,0 +1,396 @@
+// pkhouse-cli - command line front end for save and bank files on a host PC.
+// Uses the same SaveFile/Bank code as the Switch app, so batch jobs can be
+// scripted and the core profiled with standard tools (perf, valgrind, ...).
+
+#include "save_file.h"
+#include "bank.h"
+#include "species_converter.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#ifndef PKHOUSE_DATA_DIR
+#define PKHOUSE_DATA_DIR "romfs/data/"
+#endif
+
+// Command line names, in GameType order
+static constexpr const char* GAME_NAMES[GAME_TYPE_COUNT] = {
+    "ZA", "S", "V", "Sw", "Sh", "BD", "SP", "LA", "GP", "GE", "FR", "LG",
+    "FR_ES", "LG_ES", "FR_DE", "LG_DE", "FR_IT", "LG_IT", "FR_FR", "LG_FR", "FR_JA", "LG_JA"
+};
+
+static void usage() {
+    std::fprintf(stderr,
+        "usage: pkhouse-cli <command> -g <game> <file> [args]\n"
+        "\n"
+        "commands:\n"
+        "  list   <file>                          box names and occupancy\n"
+        "  dump   <file> [box]                    one line per Pokemon\n"
+        "  move   <file> <box:slot> <box:slot> [dest-file]\n"
+        "                                         move a Pokemon to an empty slot\n"
+        "  export <file> <out-dir> [box]          write Pokemon as decrypted files\n"
+        "  import <file> <pk-file>...             place files in the first empty slots\n"
+        "\n"
+        "<file> is a save file (main, SaveData.bin, ...) or a pkHouse bank (.bin).\n"
+        "Boxes and slots are numbered from 1. A missing bank file is created.\n"
+        "\n"
+        "games:");
+    for (int i = 0; i < GAME_TYPE_COUNT; i++)
+        std::fprintf(stderr, " %s", GAME_NAMES[i]);
+    std::fprintf(stderr, "\n");
+}
+
+static bool parseGame(const char* name, GameType& out) {
+    for (int i = 0; i < GAME_TYPE_COUNT; i++) {
+        if (std::strcmp(name, GAME_NAMES[i]) == 0) {
+            out = static_cast<GameType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// "box:slot", 1-based on the command line, 0-based out
+static bool parseBoxSlot(const char* s, int& box, int& slot) {
+    int b = 0, sl = 0;
+    if (std::sscanf(s, "%d:%d", &b, &sl) != 2 || b < 1 || sl < 1)
+        return false;
+    box = b - 1;
+    slot = sl - 1;
+    return true;
+}
+
+// Smallest valid size of a decrypted Pokemon file for a game (box format)
+static int storedSize(GameType g) {
+    if (isFRLG(g)) return PokeCrypto::SIZE_3STORED;
+    if (isLGPE(g)) return PokeCrypto::SIZE_6STORED;
+    if (g == GameType::LA) return PokeCrypto::SIZE_8ASTORED;
+    return PokeCrypto::SIZE_9STORED;
+}
+
+// A save file or a bank behind one interface
+class Container {
+public:
+    bool open(const std::string& path, GameType game) {
+        path_ = path;
+        game_ = game;
+        isBank_ = isBankFile(path);
+        if (isBank_) {
+            bank_.setGameType(game);
+            if (!bank_.load(path))
+                return false;
+            // Re-apply: load() takes the file's layout
+            bank_.setGameType(game);
+            return true;
+        }
+        save_.setGameType(game);
+        return save_.load(path);
+    }
+
+    bool write() { return isBank_ ? bank_.save(path_) : save_.save(path_); }
+
+    bool isBank() const { return isBank_; }
+    const std::string& path() const { return path_; }
+    int boxCount() const { return isBank_ ? bank_.boxCount() : save_.boxCount(); }
+    int slotsPerBox() const { return isBank_ ? bank_.slotsPerBox() : save_.slotsPerBox(); }
+
+    std::string boxName(int box) const {
+        return isBank_ ? bank_.getBoxName(box) : save_.getBoxName(box);
+    }
+
+    Pokemon get(int box, int slot) const {
+        return isBank_ ? bank_.getSlot(box, slot) : save_.getBoxSlot(box, slot);
+    }
+
+    // LGPE party members live in the box list but must stay where they are
+    bool isLocked(int box, int slot) const {
+        return !isBank_ && isLGPE(game_) && save_.isLGPEPartySlot(box, slot);
+    }
+
+    void set(int box, int slot, const Pokemon& pkm) {
+        if (isBank_) bank_.setSlot(box, slot, pkm);
+        else         save_.setBoxSlot(box, slot, pkm);
+    }
+
+    void setMany(const std::vector<SaveFile::BoxSlotWrite>& writes) {
+        if (!isBank_) {
+            save_.setBoxSlots(writes);
+            return;
+        }
+        for (const auto& w : writes)
+            bank_.setSlot(w.box, w.slot, w.pkm);
+    }
+
+    void clear(int box, int slot) {
+        if (isBank_) bank_.clearSlot(box, slot);
+        else         save_.clearBoxSlot(box, slot);
+    }
+
+    bool validSlot(int box, int slot) const {
+        return box >= 0 && box < boxCount() && slot >= 0 && slot < slotsPerBox();
+    }
+
+private:
+    static bool isBankFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return true; // Bank::load() starts an empty bank
+        char magic[8] = {};
+        file.read(magic, 8);
+        return std::memcmp(magic, "PKHOUSE\0", 8) == 0;
+    }
+
+    std::string path_;
+    GameType game_ = GameType::ZA;
+    bool isBank_ = false;
+    SaveFile save_;
+    Bank bank_;
+};
+
+static bool openOrFail(Container& c, const std::string& path, GameType game) {
+    if (c.open(path, game))
+        return true;
+    std::fprintf(stderr, "error: cannot load %s as %s\n", path.c_str(), GAME_NAMES[(int)game]);
+    return false;
+}
+
+static int cmdList(Container& c) {
+    int total = 0;
+    for (int b = 0; b < c.boxCount(); b++) {
+        int count = 0;
+        for (int s = 0; s < c.slotsPerBox(); s++)
+            if (!c.get(b, s).isEmpty()) count++;
+        total += count;
+        std::printf("box %2d  %2d/%d  %s\n", b + 1, count, c.slotsPerBox(), c.boxName(b).c_str());
+    }
+    std::printf("%d Pokemon in %d boxes (%s)\n", total, c.boxCount(), c.isBank() ? "bank" : "save");
+    return 0;
+}
+
+static void dumpSlot(int box, int slot, const Pokemon& pkm) {
+    static constexpr char GENDER[4] = {'M', 'F', '-', '?'};
+    std::string flags;
+    if (pkm.isShiny()) flags += "S";
+    if (pkm.isAlpha()) flags += "A";
+    if (pkm.isEgg())   flags += "E";
+
+    std::printf("%2d:%-2d  #%04u-%02u  %-12s  Lv%3u  %c  %-3s  IV %2u/%2u/%2u/%2u/%2u/%2u  %-10s  %s  OT %s (%05u)\n",
+                box + 1, slot + 1, pkm.species(), pkm.form(),
+                SpeciesName::get(pkm.species()).c_str(), pkm.level(),
+                GENDER[pkm.gender() & 3], flags.c_str(),
+                pkm.ivHp(), pkm.ivAtk(), pkm.ivDef(), pkm.ivSpA(), pkm.ivSpD(), pkm.ivSpe(),
+                NatureName::get(pkm.nature()).c_str(), pkm.displayName().c_str(),
+                pkm.otName().c_str(), pkm.tid());
+}
+
+static int cmdDump(Container& c, int onlyBox) {
+    for (int b = 0; b < c.boxCount(); b++) {
+        if (onlyBox >= 0 && b != onlyBox)
+            continue;
+        for (int s = 0; s < c.slotsPerBox(); s++) {
+            Pokemon pkm = c.get(b, s);
+            if (!pkm.isEmpty())
+                dumpSlot(b, s, pkm);
+        }
+    }
+    return 0;
+}
+
+static int cmdMove(Container& src, const char* from, const char* to, Container* dst) {
+    int sb, ss, db, ds;
+    if (!parseBoxSlot(from, sb, ss) || !parseBoxSlot(to, db, ds)) {
+        std::fprintf(stderr, "error: slots are given as box:slot\n");
+        return 2;
+    }
+    Container& out = dst ? *dst : src;
+    if (!src.validSlot(sb, ss) || !out.validSlot(db, ds)) {
+        std::fprintf(stderr, "error: slot out of range\n");
+        return 2;
+    }
+    if (src.isLocked(sb, ss) || out.isLocked(db, ds)) {
+        std::fprintf(stderr, "error: party Pokemon can't be moved\n");
+        return 1;
+    }
+
+    Pokemon pkm = src.get(sb, ss);
+    if (pkm.isEmpty()) {
+        std::fprintf(stderr, "error: %s is empty\n", from);
+        return 1;
+    }
+    if (!out.get(db, ds).isEmpty()) {
+        std::fprintf(stderr, "error: %s is occupied\n", to);
+        return 1;
+    }
+
+    // Write the destination first so a failed save never loses the Pokemon
+    out.set(db, ds, pkm);
+    if (dst && !dst->write()) {
+        std::fprintf(stderr, "error: cannot write %s\n", dst->path().c_str());
+        return 1;
+    }
+    src.clear(sb, ss);
+    if (!src.write()) {
+        std::fprintf(stderr, "error: cannot write %s\n", src.path().c_str());
+        return 1;
+    }
+    std::printf("moved %s %s -> %s\n", SpeciesName::get(pkm.species()).c_str(), from, to);
+    return 0;
+}
+
+static int cmdExport(Container& c, GameType game, const std::string& outDir, int onlyBox) {
+    mkdir(outDir.c_str(), 0755);
+    std::string dir = outDir;
+    if (!dir.empty() && dir.back() != '/')
+        dir += '/';
+
+    int size = pkPartySize(game);
+    int count = 0;
+    int failed = 0;
+    for (int b = 0; b < c.boxCount(); b++) {
+        if (onlyBox >= 0 && b != onlyBox)
+            continue;
+        for (int s = 0; s < c.slotsPerBox(); s++) {
+            Pokemon pkm = c.get(b, s);
+            if (pkm.isEmpty())
+                continue;
+            // Clones share a file name; number them instead of overwriting
+            std::string name = pkm.exportFileName(game);
+            std::string path = dir + name;
+            struct stat st;
+            for (int n = 2; stat(path.c_str(), &st) == 0; n++) {
+                size_t dot = name.rfind('.');
+                path = dir + name.substr(0, dot) + " (" + std::to_string(n) + ")" + name.substr(dot);
+            }
+            FILE* f = std::fopen(path.c_str(), "wb");
+            bool ok = f && std::fwrite(pkm.data.data(), 1, size, f) == (size_t)size;
+            if (f && std::fclose(f) != 0)
+                ok = false;
+            if (!ok) {
+                if (f)
+                    std::remove(path.c_str());
+                std::fprintf(stderr, "error: cannot write %s\n", path.c_str());
+                failed++;
+                continue;
+            }
+            count++;
+        }
+    }
+    std::printf("exported %d Pokemon to %s\n", count, dir.c_str());
+    return failed ? 1 : 0;
+}
+
+static int cmdImport(Container& c, GameType game, char** files, int fileCount) {
+    std::vector<SaveFile::BoxSlotWrite> writes;
+    int box = 0, slot = 0;
+    int failed = 0;
+
+    for (int i = 0; i < fileCount; i++) {
+        std::ifstream file(files[i], std::ios::binary);
+        std::vector<uint8_t> buf((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+        if (buf.size() < (size_t)storedSize(game) || buf.size() > PokeCrypto::MAX_PARTY_SIZE) {
+            std::fprintf(stderr, "skip: %s is not a %s file\n", files[i], pkFileExtension(game));
+            failed++;
+            continue;
+        }
+
+        Pokemon pkm;
+        pkm.gameType_ = game;
+        std::memcpy(pkm.data.data(), buf.data(), buf.size());
+        if (pkm.isEmpty()) {
+            std::fprintf(stderr, "skip: %s holds no Pokemon\n", files[i]);
+            failed++;
+            continue;
+        }
+
+        // Next empty slot after the previous placement
+        bool found = false;
+        while (box < c.boxCount()) {
+            if (!c.isLocked(box, slot) && c.get(box, slot).isEmpty()) {
+                found = true;
+                break;
+            }
+            if (++slot == c.slotsPerBox()) { slot = 0; box++; }
+        }
+        if (!found) {
+            std::fprintf(stderr, "error: no empty slot left for %s\n", files[i]);
+            failed += fileCount - i;
+            break;
+        }
+
+        writes.push_back({box, slot, pkm});
+        if (++slot == c.slotsPerBox()) { slot = 0; box++; }
+    }
+
+    if (!writes.empty()) {
+        c.setMany(writes);
+        if (!c.write()) {
+            std::fprintf(stderr, "error: cannot write %s\n", c.path().c_str());
+            return 1;
+        }
+    }
+    std::printf("imported %zu Pokemon, %d skipped\n", writes.size(), failed);
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Pull out "-g <game>", keep the rest in order
+    GameType game = GameType::ZA;
+    bool haveGame = false;
+    std::vector<char*> args;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            if (!parseGame(argv[++i], game)) {
+                std::fprintf(stderr, "error: unknown game '%s'\n", argv[i]);
+                usage();
+                return 2;
+            }
+            haveGame = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (!haveGame || args.size() < 2) {
+        usage();
+        return 2;
+    }
+
+    std::string dataDir = PKHOUSE_DATA_DIR;
+    if (const char* env = std::getenv("PKHOUSE_DATA"))
+        dataDir = std::string(env) + "/";
+    SpeciesName::load(dataDir + "species_en.txt");
+    NatureName::load(dataDir + "natures_en.txt");
+
+    std::string cmd = args[0];
+    int n = static_cast<int>(args.size()) - 2; // arguments after <file>
+    char** rest = args.data() + 2;
+
+    Container c;
+    if (!openOrFail(c, args[1], game))
+        return 1;
+
+    if (cmd == "list" && n == 0)
+        return cmdList(c);
+    if (cmd == "dump" && n <= 1)
+        return cmdDump(c, n == 1 ? std::atoi(rest[0]) - 1 : -1);
+    if (cmd == "move" && (n == 2 || n == 3)) {
+        if (n == 2 || std::strcmp(rest[2], args[1]) == 0)
+            return cmdMove(c, rest[0], rest[1], nullptr);
+        Container dst;
+        if (!openOrFail(dst, rest[2], game))
+            return 1;
+        return cmdMove(c, rest[0], rest[1], &dst);
+    }
+    if (cmd == "export" && (n == 1 || n == 2))
+        return cmdExport(c, game, rest[0], n == 2 ? std::atoi(rest[1]) - 1 : -1);
+    if (cmd == "import" && n >= 1)
+        return cmdImport(c, game, rest, n);
+
+    usage();
+    return 2;
+}
@@ -1,11 +1,15 @@
 #pragma once
 #include "pokemon.h"
 #include "game_type.h"
+#include "search_index.h"
 #include <string>
 #include <vector>
 
 // Bank - persistent storage for extracted Pokemon.
 // Stores decrypted Pokemon data in a simple binary file format.
+// Loading is lazy: load() only reads the header and box names, and each box's
+// slots are read from the file the first time one of them is accessed. Slots
+// are kept at their native slotSize_; a Pokemon is built only by getSlot().
 class Bank {
 public:
 
@@ -14,9 +18,12 @@ public:
     void setGameType(GameType g);
 
     // Load bank from file. Returns true on success; creates empty bank if file missing.
+    // Slot data is read per box on first access (see ensureBox()).
     bool load(const std::string& path);
 
-    // Save bank to file.
+    // Save bank to file. When path is the file this bank was loaded from (or
+    // last saved to) in the same format, only the dirty slots and box names
+    // are rewritten in place; otherwise the whole file is written.
     bool save(const std::string& path);
 
     Pokemon getSlot(int box, int slot) const;
@@ -26,20 +33,58 @@ public:
     std::string getBoxName(int box) const;
     void setBoxName(int box, const std::string& name);
 
+    // Number of non-empty slots. Taken from the header when the file has an
+    // occupancy index and kept up to date by setSlot()/clearSlot(); otherwise
+    // every box is read once to count.
+    int occupiedCount() const;
+
+    // Number of boxes currently held in memory (for diagnostics).
+    int residentBoxCount() const;
+
+    // A box could not be read from the bank file (e.g. it was removed after
+    // load). Unread boxes read as empty and save() refuses a full rewrite.
+    // Cleared by load().
+    bool sourceError() const { return sourceError_; }
+
+    // Occupancy count stored in a bank file's header, or -1 if the file has
+    // none (older files, or files written by older versions). Reads 16 bytes.
+    static int readOccupancyIndex(const std::string& path);
+    // Store an occupancy count in an existing bank file's header in place.
+    static bool writeOccupancyIndex(const std::string& path, int count);
+
+    // Searchable slot attributes. Built on first use (reading every box) and
+    // kept current by setSlot()/clearSlot() afterwards.
+    const SearchIndex& searchIndex() const;
+
+    // Attribute summary persisted next to a bank file ("Name.idx"), used to
+    // search banks without loading them. save() rewrites it when the index
+    // is built and removes it otherwise. fileStamp() identifies the bank
+    // file's current contents, or 0 if it can't be read. It mixes the save
+    // generation, the header occupancy word, size and mtime: every save()
+    // bumps the generation, so a file restored with its old timestamp (or
+    // changed within FAT's 2-second mtime step) still gets a new stamp.
+    static std::string indexPathFor(const std::string& bankPath);
+    static uint64_t fileStamp(const std::string& bankPath);
+
     int boxCount() const { return boxCount_; }
     int slotsPerBox() const { return slotsPerBox_; }
     int totalSlots() const { return boxCount_ * slotsPerBox_; }
-    size_t fileSize() const { return HEADER_SIZE + (size_t)totalSlots() * slotSize_ + (size_t)boxCount_ * BOX_NAME_SIZE; }
+    size_t fileSize() const { return namesOffset() + (size_t)boxCount_ * BOX_NAME_SIZE + GENERATION_SIZE; }
 
 private:
     // File format:
     //   [8 bytes]  Magic: "PKHOUSE\0"
     //   [4 bytes]  Version (u32 LE): 1 = 32 boxes, 2 = 40 boxes
-    //   [4 bytes]  Reserved
-    //   [N bytes]  totalSlots * SIZE_9PARTY decrypted data
-    static constexpr int HEADER_SIZE   = 16;
-    static constexpr int SLOT_SIZE     = PokeCrypto::SIZE_9PARTY;
-    static constexpr int BOX_NAME_SIZE = 16;
+    //   [4 bytes]  Occupancy index (u32 LE): OCCUPANCY_VALID | occupied slot
+    //              count, or 0 if absent (older files, treated as unknown)
+    //   [N bytes]  totalSlots * slotSize_ decrypted data
+    //   [M bytes]  boxCount * BOX_NAME_SIZE box names
+    //   [8 bytes]  Save generation (u64 LE), bumped by every save(); absent
+    //              in files written by older versions (read as 0)
+    static constexpr int HEADER_SIZE     = 16;
+    static constexpr int SLOT_SIZE       = PokeCrypto::SIZE_9PARTY;
+    static constexpr int BOX_NAME_SIZE   = 16;
+    static constexpr int GENERATION_SIZE = 8;
 
     static constexpr char MAGIC[8] = {'P','K','H','O','U','S','E','\0'};
     static constexpr uint32_t VERSION_32BOX = 1;
@@ -48,13 +93,42 @@ private:
     static constexpr uint32_t VERSION_LGPE  = 4;
     static constexpr uint32_t VERSION_FRLG  = 5;
 
+    static constexpr int      OCCUPANCY_OFFSET = 12;
+    static constexpr uint32_t OCCUPANCY_VALID  = 0x80000000;
+
     GameType gameType_ = GameType::ZA;
     int boxCount_ = 32;
     int slotsPerBox_ = 30;
     int slotSize_ = PokeCrypto::SIZE_9PARTY;
-    std::vector<Pokemon> slots_;
     std::vector<std::string> boxNames_;
 
+    // Slot data per box, slotsPerBox_ * slotSize_ bytes each. An empty vector
+    // means the box has not been read yet: ensureBox() fills it from
+    // sourcePath_ (or with zeros when there is no source file).
+    mutable std::vector<std::vector<uint8_t>> boxData_;
+    std::string sourcePath_;
+    mutable bool sourceError_ = false;  // a box could not be read from sourcePath_
+    mutable int occupied_ = 0;          // -1 = unknown until counted
+    mutable SearchIndex searchIndex_;
+    uint64_t generation_ = 0;           // of the file last loaded or saved
+
+    uint8_t* ensureBox(int box) const;
+    uint8_t* slotBytes(int idx) const;
+    void loadAllBoxes() const;
+    bool isSlotEmpty(int idx) const;
+
+    // Dirty tracking for partial saves. cleanPath_ is the file whose contents
+    // match boxData_/boxNames_ except for entries flagged dirty (empty = unknown,
+    // forcing a full write). cleanVersion_ is that file's header version.
+    std::vector<uint8_t> slotDirty_;
+    std::vector<uint8_t> nameDirty_;
+    std::string cleanPath_;
+    uint32_t cleanVersion_ = 0;
+
+    bool saveFull(const std::string& path);
+    bool savePartial(const std::string& path);
+    void markAllClean(const std::string& path);
+
     uint32_t fileVersion() const {
         if (isFRLG(gameType_)) return VERSION_FRLG;
         if (isLGPE(gameType_)) return VERSION_LGPE;
@@ -62,6 +136,11 @@ private:
         return boxCount_ == 40 ? VERSION_40BOX : VERSION_32BOX;
     }
 
+    // Slot layout for a header version; false if the version is unknown
+    static bool layoutFor(uint32_t version, int& boxCount, int& slotSize, int& slotsPerBox);
+
+    size_t namesOffset() const { return HEADER_SIZE + (size_t)totalSlots() * slotSize_; }
+
     int slotIndex(int box, int slot) const {
         return box * slotsPerBox_ + slot;
     }
@@ -27,6 +27,13 @@ public:
 
     // Scan all game folders and build a combined bank list
     bool initAll(const std::string& basePath);
+    // The same combined list, without changing the manager's state
+    static std::vector<BankInfo> scanAll(const std::string& basePath);
+
+    // Load the searchable attributes of a bank on disk. Uses the bank's
+    // persisted summary when it matches the file; otherwise loads the bank
+    // once, builds the index and stores a fresh summary for next time.
+    static bool loadSearchIndex(const BankInfo& info, SearchIndex& index);
     bool isAllMode() const { return allMode_; }
 
     // Visual row helpers for grouped display (headers + bank entries)
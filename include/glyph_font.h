@@ -0,0 +1,88 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+typedef struct FT_FaceRec_* FT_Face;
+typedef struct hb_font_t hb_font_t;
+typedef struct hb_buffer_t hb_buffer_t;
+
+struct TextExtent {
+    int w = 0;
+    int h = 0;
+};
+
+// GlyphFont - one font at one pixel size, drawn from a glyph atlas.
+//
+// Strings are shaped with HarfBuzz and the layout is cached per string
+// (colour-independent, so theme changes keep it). Glyphs are rasterised
+// with FreeType once into a single white-on-alpha atlas texture; drawing a
+// string is one SDL_RenderGeometry call with the colour in the vertices.
+// If the atlas fills up it is wiped and refilled from the glyphs in use,
+// so memory stays fixed at one texture per font; a string that fills it
+// part-way is drawn in two calls, split at the wipe.
+class GlyphFont {
+public:
+    // data must stay valid for the font's lifetime (e.g. the system shared font)
+    static GlyphFont* fromMemory(SDL_Renderer* renderer, const void* data, size_t size,
+                                 int pixelSize);
+    static GlyphFont* fromFile(SDL_Renderer* renderer, const std::string& path,
+                               int pixelSize);
+    ~GlyphFont();
+
+    GlyphFont(const GlyphFont&) = delete;
+    GlyphFont& operator=(const GlyphFont&) = delete;
+
+    int height() const { return ascent_ - descent_; }
+    TextExtent measure(const std::string& utf8);
+    // (x, y) is the top-left of the line box, as with SDL_ttf surfaces
+    void draw(const std::string& utf8, int x, int y, SDL_Color color);
+
+private:
+    GlyphFont() = default;
+    bool init(SDL_Renderer* renderer, const void* data, size_t size, int pixelSize);
+
+    struct ShapedGlyph {
+        uint32_t gid;
+        int      x, y;      // pen position relative to the line origin
+    };
+    struct ShapedRun {
+        std::vector<ShapedGlyph> glyphs;
+        int width = 0;
+    };
+    struct AtlasSlot {
+        SDL_Rect rect;      // in the atlas; w == 0 for blank glyphs
+        int      left, top; // bitmap bearing
+    };
+
+    SDL_Renderer* renderer_ = nullptr;
+    std::vector<uint8_t> fileData_;     // owned font bytes for fromFile()
+    FT_Face       face_   = nullptr;
+    hb_font_t*    hbFont_ = nullptr;
+    hb_buffer_t*  hbBuf_  = nullptr;
+    int ascent_  = 0;
+    int descent_ = 0;                   // negative, below the baseline
+
+    static constexpr size_t SHAPE_CACHE_MAX = 512;
+    std::unordered_map<std::string, ShapedRun> shapeCache_;
+    const ShapedRun& shape(const std::string& utf8);
+
+    // Atlas: shelf-packed, 1px gutter
+    SDL_Texture* atlas_ = nullptr;
+    int atlasSize_ = 0;
+    int penX_ = 0, penY_ = 0, shelfH_ = 0;
+    std::unordered_map<uint32_t, AtlasSlot> slots_;
+    // The returned slot is only valid until the next call: a full atlas is
+    // wiped, after the quads queued so far are drawn from the old contents.
+    const AtlasSlot* glyphSlot(uint32_t gid);
+    void resetAtlas();
+
+    // Quads queued by draw(), submitted by flushGeometry()
+    std::vector<SDL_Vertex> verts_;
+    std::vector<int>        indices_;
+    void flushGeometry();
+    std::vector<uint8_t>    pixels_;
+};
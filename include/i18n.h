@@ -65,6 +65,9 @@ namespace StrKey {
     constexpr const char* LoadingGameIcons     = "loading_game_icons";
     constexpr const char* LoadingProfiles      = "loading_profiles";
     constexpr const char* Saving               = "saving";
+    constexpr const char* SavingBanks          = "saving_banks";
+    constexpr const char* SavingGameData       = "saving_game_data";
+    constexpr const char* CommittingSave       = "committing_save";
     constexpr const char* LoadingSaveData      = "loading_save_data";
     constexpr const char* MountError           = "mount_error";
     constexpr const char* FailedMountSave      = "failed_mount_save";
@@ -87,6 +90,11 @@ namespace StrKey {
     constexpr const char* AConfirmBCancel      = "a_confirm_b_cancel";
     constexpr const char* CannotDelete         = "cannot_delete";
     constexpr const char* BankCurrentlyLoaded  = "bank_currently_loaded";
+    constexpr const char* CannotRename         = "cannot_rename";
+    constexpr const char* BankReadError        = "bank_read_error";
+    constexpr const char* BankReadErrorBody    = "bank_read_error_body";
+    constexpr const char* BankSaveFailed       = "bank_save_failed";
+    constexpr const char* BankSaveFailedBody   = "bank_save_failed_body";
     constexpr const char* DeletingBank         = "deleting_bank";
     constexpr const char* EnterBankName        = "enter_bank_name";
     constexpr const char* RenameBank           = "rename_bank";
@@ -103,6 +111,8 @@ namespace StrKey {
     constexpr const char* BankAlreadyRight     = "bank_already_right";
     constexpr const char* BankAlreadyLeft      = "bank_already_left";
     constexpr const char* LoadingBank          = "loading_bank";
+    constexpr const char* Searching            = "searching";
+    constexpr const char* SearchingProgress    = "searching_progress";
     constexpr const char* NoBankLoaded         = "no_bank_loaded";
 
     // ui_selectors.cpp
@@ -279,6 +289,10 @@ namespace StrKey {
     constexpr const char* Controls             = "controls";
     constexpr const char* ControlsLine1        = "controls_line1";
     constexpr const char* ControlsLine2        = "controls_line2";
+    constexpr const char* TextureCacheUsage    = "texture_cache_usage";
+    constexpr const char* TraceEmpty           = "trace_empty";
+    constexpr const char* TraceSaved           = "trace_saved";
+    constexpr const char* TraceWriteFailed     = "trace_write_failed";
     constexpr const char* PressMinusBClose     = "press_minus_b_close";
 
     // ui_render.cpp - box view overlay
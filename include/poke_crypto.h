@@ -31,9 +31,17 @@ namespace PokeCrypto {
     // Largest party size across all formats (for Pokemon data array sizing)
     constexpr int MAX_PARTY_SIZE = SIZE_8APARTY; // 0x178
 
-    // LCG-based XOR cipher on uint16 pairs.
+    // LCG-based XOR cipher on uint16 pairs. Generates the keystream 8 seeds
+    // at a time with NEON/SSE2 lanes using LCG jump-ahead.
     void cryptArray(uint8_t* data, size_t len, uint32_t seed);
 
+    // Serial reference implementation of cryptArray (same output), kept to
+    // verify and benchmark the vector path against.
+    void cryptArrayScalar(uint8_t* data, size_t len, uint32_t seed);
+
+    // Per-entity decrypt/encrypt. Each is a single pass from the input to
+    // outBuf (no temporary copy), so the two must not overlap.
+
     // Decrypt/encrypt Gen8/Gen9 Pokemon data (PK8, PB8, PA9).
     void decryptArray9(const uint8_t* ekm, size_t len, uint8_t* outBuf);
     void encryptArray9(const uint8_t* pk, size_t len, uint8_t* outBuf);
@@ -51,4 +59,20 @@ namespace PokeCrypto {
     void decryptArray3(const uint8_t* ekm, size_t len, uint8_t* outBuf);
     void encryptArray3(const uint8_t* pk, size_t len, uint8_t* outBuf);
 
+
+    // Entity layout, matching the *Array9/8A/6/3 functions above.
+    enum class Format { Gen9, Gen8A, Gen6, Gen3 };
+
+    // Decrypt `count` consecutive box slots, `stride` bytes apart, the last
+    // `gap` bytes of each being padding (entity length = stride - gap), into
+    // the separate buffers outs[0..count). Prefetches the next slot while
+    // working on one.
+    void decryptBox(Format fmt, const uint8_t* box, int count, size_t stride, size_t gap,
+                    uint8_t* const* outs);
+
+    // Inverse of decryptBox(): encrypt the `count` entities ins[0..count)
+    // into consecutive slots of `box` and zero each slot's gap bytes.
+    void encryptBox(Format fmt, const uint8_t* const* ins, int count,
+                    uint8_t* box, size_t stride, size_t gap);
+
 } // namespace PokeCrypto
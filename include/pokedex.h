@@ -12,6 +12,8 @@
 //   LGPE     — Zukan7b   (flat binary, block at 0x02A00)
 //   LA       — skipped   (research-task based, not applicable)
 
+#include <cstddef>
+
 struct Pokemon;
 class SaveFile;
 
@@ -21,4 +23,8 @@ namespace Pokedex {
 // Skips eggs and empty slots.  Safe to call for any GameType.
 void registerPokemon(SaveFile& save, const Pokemon& pkm);
 
+// Register several Pokemon. Dex blocks, GBA sectors and the save language
+// are looked up once for the whole batch instead of once per Pokemon.
+void registerPokemon(SaveFile& save, const Pokemon* pkms, size_t count);
+
 } // namespace Pokedex
@@ -196,10 +196,23 @@ struct Pokemon {
 
     std::string displayName() const;
 
+    // PKHeX-style export file name for this Pokemon as a `game` file:
+    // "{tag} - {species:0000}[ - form][ - [flags]] - {name} - {chk:X4}{EC:X8}.{ext}"
+    std::string exportFileName(GameType game) const;
+
     void refreshChecksum();
     void loadFromEncrypted(const uint8_t* encrypted, size_t len);
     void getEncrypted(uint8_t* outBuf);
 
+    // A run of `count` consecutive box slots, `stride` bytes apart with `gap`
+    // padding bytes at the end of each, decrypted into / encrypted from an
+    // array in one pass (PokeCrypto::decryptBox/encryptBox). encryptBox()
+    // refreshes each checksum first, like getEncrypted().
+    static void decryptBox(GameType game, const uint8_t* box, int count,
+                           size_t stride, size_t gap, Pokemon* out);
+    static void encryptBox(GameType game, Pokemon* pkms, int count,
+                           uint8_t* box, size_t stride, size_t gap);
+
     // Language: byte at format-specific offset
     uint8_t language() const {
         int o = ofs().languageByte;
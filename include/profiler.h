@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Subsystems timed by Profiler::Scope probes
+enum class ProfZone : uint8_t {
+    Present,        // SDL_RenderPresent (includes the vsync wait)
+    Draw,           // UI::drawFrame and the selector screens
+    SlotDisplays,   // rebuilding a box's SlotDisplay cache
+    SpriteLoad,     // PNG decode + upload of an uncached texture
+    Text,           // shaping, glyph rasterisation and text quads
+    BoxDecrypt,     // SaveFile box cache misses
+    SaveLoad,
+    SaveWrite,
+    BankLoad,       // Bank::load and lazy box reads
+    BankSave,
+    SwishCrypt,     // SwishCrypto payload decrypt / encrypt
+    SwishHash,
+    Count
+};
+
+// Profiler - scoped timing probes for the UI and the save/bank core.
+//
+// Disabled by default; a disabled Scope costs one relaxed atomic load.
+// Once enabled, every probe adds its duration to the current frame's
+// per-zone totals (read back with lastFrame() after frameMark()) and
+// records a complete event in a fixed-size ring, which writeChromeTrace()
+// dumps as Chrome trace JSON (chrome://tracing, Perfetto). Probes may run
+// on any thread.
+class Profiler {
+public:
+    struct FrameStats {
+        double   frameMs = 0;                       // frameMark() to frameMark()
+        double   zoneMs[size_t(ProfZone::Count)] = {};
+        uint32_t calls[size_t(ProfZone::Count)]  = {};
+    };
+
+    class Scope {
+    public:
+        explicit Scope(ProfZone zone)
+            : zone_(zone), active_(enabled_.load(std::memory_order_relaxed)) {
+            if (active_)
+                start_ = std::chrono::steady_clock::now();
+        }
+        ~Scope() {
+            if (active_)
+                record(zone_, start_, std::chrono::steady_clock::now());
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ProfZone zone_;
+        bool     active_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    static void setEnabled(bool on);
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Close the current frame: its totals become lastFrame()
+    static void frameMark();
+    static FrameStats lastFrame();
+
+    static const char* zoneName(ProfZone zone);
+
+    // Events currently buffered for the trace
+    static size_t eventCount();
+    // Write the buffered events (oldest first) as Chrome trace JSON
+    static bool writeChromeTrace(const std::string& path);
+
+private:
+    static std::atomic<bool> enabled_;
+    static void record(ProfZone zone, std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end);
+};
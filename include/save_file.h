@@ -3,7 +3,11 @@
 #include "pokemon.h"
 #include "game_type.h"
 #include "wondercard.h"
+#include "search_index.h"
 #include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -24,13 +28,27 @@ public:
     void setBoxSlot(int box, int slot, Pokemon pkm);
     void clearBoxSlot(int box, int slot);
 
+    // Place several Pokemon in one pass. Trainer info and Pokedex blocks are
+    // resolved once for the batch and each affected box is invalidated once,
+    // so placing a full box costs about the same as placing one Pokemon.
+    struct BoxSlotWrite {
+        int box;
+        int slot;
+        Pokemon pkm;
+    };
+    void setBoxSlots(const std::vector<BoxSlotWrite>& writes);
+
     std::string getBoxName(int box) const;
 
     bool isLoaded() const { return loaded_; }
     GameType gameType() const { return gameType_; }
 
-    // Access SCBlock by key (for SCBlock-based games: ZA/SV/SwSh/LA)
-    SCBlock* findBlock(uint32_t key) { return SwishCrypto::findBlock(blocks_, key); }
+    // Access SCBlock by key (for SCBlock-based games: ZA/SV/SwSh/LA).
+    // O(1) lookup through blockIndex_, built once in loadSCBlock().
+    // The mutable overload marks the block dirty so the next save
+    // re-encrypts it.
+    SCBlock* findBlock(uint32_t key);
+    const SCBlock* findBlock(uint32_t key) const;
 
     // Access raw save data (for flat binary games: BDSP/LGPE/FRLG)
     uint8_t* rawData() { return rawData_.data(); }
@@ -40,16 +58,51 @@ public:
     // Returns pointer to the sector's 0x1000-byte region, or nullptr.
     uint8_t* findGbaSectorData(int sectionId);
 
-    // Get trainer info from save file (SV/ZA only, SCBlock-based)
-    TrainerInfo getTrainerInfo() const;
+    // Get trainer info from save file. Parsed once per load and cached; the
+    // cache is dropped when the MyStatus block is handed out for writing
+    // through findBlock(). The reference stays valid until then.
+    const TrainerInfo& getTrainerInfo() const;
 
     // Get save file language (shorthand for getTrainerInfo().language)
-    uint8_t saveLanguage() const { auto ti = getTrainerInfo(); return ti.valid ? ti.language : 0; }
+    uint8_t saveLanguage() const { const auto& ti = getTrainerInfo(); return ti.valid ? ti.language : 0; }
 
-    // Debug: verify encrypt(decrypt(file)) == file. Call right after load().
+    // Debug: verify encrypt(decrypt(file)) == file. Call right after load(),
+    // before anything is modified (compares against the retained image).
     // Returns "OK" if round-trip matches, or a description of the mismatch.
     std::string verifyRoundTrip();
 
+    // Decrypted box cache (LRU). Capacity is in boxes and can be tuned per
+    // game; shrinking it evicts the least recently used boxes right away.
+    struct BoxCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;       // getBoxSlot() had to decrypt the box
+        uint64_t prefetched = 0;   // boxes decrypted by runPrefetch()
+        uint64_t evictions = 0;
+    };
+    void setBoxCacheCapacity(int boxes);
+    int boxCacheCapacity() const { return boxCacheCapacity_; }
+    const BoxCacheStats& boxCacheStats() const { return boxCacheStats_; }
+    void resetBoxCacheStats() { boxCacheStats_ = {}; }
+
+    // Queue the boxes next to `box` (wrapping) for decryption, so paging to
+    // them hits the cache. The work is done by runPrefetch(), one box per
+    // call, from the UI loop's idle time; returns true while more is queued.
+    void prefetchBoxesAround(int box);
+    bool runPrefetch();
+
+    // Searchable box slot attributes. Built on first use (decrypting every
+    // slot once, bypassing the box cache) and kept current by
+    // setBoxSlot()/setBoxSlots()/clearBoxSlot() afterwards.
+    const SearchIndex& searchIndex() const;
+
+    // Call fn(box, slot, pkm) for every slot held in the save, decrypting
+    // whole boxes on the shared TaskPool (one task per box, bypassing the
+    // box cache). fn runs concurrently for different boxes and must only
+    // write state owned by that slot, e.g. element box * slotsPerBox() + slot
+    // of a pre-sized vector; results are then in slot order regardless of
+    // which thread handled which box. Returns once every slot has been seen.
+    void forEachSlotParallel(const std::function<void(int box, int slot, const Pokemon& pkm)>& fn) const;
+
     // Dynamic box count and slots per box
     int boxCount() const { return boxCount_; }
     int slotsPerBox() const { return slotsPerBox_; }
@@ -65,6 +118,29 @@ public:
 private:
     std::vector<SCBlock> blocks_;
 
+    // Decrypted SCBlock save image. blocks_ hold views into this buffer
+    // instead of owning one allocation each (see SCBlockData).
+    std::vector<uint8_t> blockArena_;
+
+    // Encrypted save image as last loaded or written, with each block's
+    // encoded offset in it (blocks_.size() + 1 entries, last = payload end).
+    // saveSCBlock() re-encrypts and writes back only the blocks marked
+    // dirty, as long as none of them changed size.
+    std::vector<uint8_t> encryptedImage_;
+    std::vector<size_t>  blockOffsets_;
+    std::vector<uint8_t> blockDirty_;
+    std::string imagePath_;                  // file encryptedImage_ matches on disk
+    size_t boxBlockIdx_ = SIZE_MAX;
+    SCBlock* lookupBlock(uint32_t key);      // findBlock() without marking dirty
+    void rebuildBlockOffsets();
+    void markBlockDirty(size_t idx) { if (idx < blockDirty_.size()) blockDirty_[idx] = 1; }
+
+    // Block key -> index into blocks_. Blocks are only ever mutated in place
+    // (never added, removed or reordered), so indices stay valid until the
+    // next loadSCBlock() rebuilds the map.
+    std::unordered_map<uint32_t, size_t> blockIndex_;
+    void rebuildBlockIndex();
+
     // Cached pointers into block data (SCBlock) or raw data (BDSP)
     uint8_t* boxData_       = nullptr;
     size_t   boxDataLen_    = 0;
@@ -84,6 +160,13 @@ private:
     // SCBlock keys
     uint32_t kbox_ = 0x0d66012c;                        // LA uses 0x47E1CEAB
     static constexpr uint32_t KBOX_LAYOUT = 0x19722c89; // same for all games
+    static constexpr uint32_t KMYSTATUS_8 = 0xf25c070e; // SwSh/LA
+    static constexpr uint32_t KMYSTATUS_9 = 0xE3E89BD1; // SV/ZA
+
+    // Parsed trainer info (see getTrainerInfo())
+    mutable TrainerInfo trainerInfo_;
+    mutable bool trainerInfoCached_ = false;
+    TrainerInfo parseTrainerInfo() const;
 
     // BDSP save format constants
     static constexpr int BDSP_BOX_COUNT       = 40;
@@ -147,16 +230,25 @@ private:
     // BDSP and LGPE raw save data (flat binary, no SCBlocks)
     std::vector<uint8_t> rawData_;
 
-    // Original file data for round-trip verification (cleared after verify)
-    std::vector<uint8_t> originalFileData_;
-
     // Decrypted Pokemon cache: avoids re-decrypting on every getBoxSlot() call.
-    // Maps box index -> vector of decrypted Pokemon (one per slot).
-    static constexpr int BOX_CACHE_MAX = 4; // max cached boxes
-    mutable std::unordered_map<int, std::vector<Pokemon>> boxCache_;
-    void invalidateBoxCache(int box) const { boxCache_.erase(box); }
-    void invalidateAllBoxCache() const { boxCache_.clear(); }
+    // Maps box index -> decrypted Pokemon (one per slot) plus the box's
+    // position in boxLru_ (front = most recently used).
+    static constexpr int BOX_CACHE_DEFAULT = 8; // cached boxes
+    struct CachedBox {
+        std::vector<Pokemon> slots;
+        std::list<int>::iterator lruPos;
+    };
+    mutable std::unordered_map<int, CachedBox> boxCache_;
+    mutable std::list<int> boxLru_;
+    mutable BoxCacheStats boxCacheStats_;
+    int boxCacheCapacity_ = BOX_CACHE_DEFAULT;
+    std::vector<int> prefetchQueue_;
+    mutable SearchIndex searchIndex_;
+    void invalidateBoxCache(int box) const;
+    void invalidateAllBoxCache() const { boxCache_.clear(); boxLru_.clear(); }
     const std::vector<Pokemon>& getCachedBox(int box) const;
+    CachedBox& decryptBoxToCache(int box) const;
+    void evictBoxesOver(int capacity) const;
 
     bool loadSCBlock(const std::string& path);
     bool saveSCBlock(const std::string& path);
@@ -175,4 +267,10 @@ private:
     int getBoxSlotOffset(int box, int slot) const {
         return getBoxOffset(box) + slot * sizeBoxSlot_;
     }
+    // Number of leading slots of `box` that lie fully inside the box data
+    // (every slot, unless the save is truncated)
+    int boxSlotsInData(int box) const {
+        int room = (static_cast<int>(boxDataLen_) - getBoxOffset(box)) / sizeBoxSlot_;
+        return room < 0 ? 0 : (room > slotsPerBox_ ? slotsPerBox_ : room);
+    }
 };
@@ -1,6 +1,9 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
+#include <algorithm>
 #include <bit>
 
 // SCXorShift32 - PRNG used to encrypt/decrypt SCBlock fields.
@@ -24,6 +27,43 @@ public:
         return next() | (next() << 8) | (next() << 16) | (next() << 24);
     }
 
+    // XOR len bytes of src with the keystream into dst (src == dst is fine).
+    // Equivalent to dst[i] = src[i] ^ next() for each byte, but consumes a
+    // whole state word per 4 bytes once the byte counter is word-aligned.
+    void xorBytes(uint8_t* dst, const uint8_t* src, size_t len) {
+        size_t i = 0;
+        // Drain the partially consumed state word
+        while (counter_ != 0 && i < len) {
+            dst[i] = src[i] ^ next();
+            i++;
+        }
+        if constexpr (std::endian::native == std::endian::little) {
+            // Keystream bytes are the state word in little-endian order
+            for (; i + 16 <= len; i += 16) {
+                uint32_t k[4];
+                k[0] = state_; state_ = xorshiftAdvance(state_);
+                k[1] = state_; state_ = xorshiftAdvance(state_);
+                k[2] = state_; state_ = xorshiftAdvance(state_);
+                k[3] = state_; state_ = xorshiftAdvance(state_);
+                uint64_t v[2], kk[2];
+                std::memcpy(v, src + i, 16);
+                std::memcpy(kk, k, 16);
+                v[0] ^= kk[0];
+                v[1] ^= kk[1];
+                std::memcpy(dst + i, v, 16);
+            }
+            for (; i + 4 <= len; i += 4) {
+                uint32_t v;
+                std::memcpy(&v, src + i, 4);
+                v ^= state_;
+                std::memcpy(dst + i, &v, 4);
+                state_ = xorshiftAdvance(state_);
+            }
+        }
+        for (; i < len; i++)
+            dst[i] = src[i] ^ next();
+    }
+
 private:
     int counter_ = 0;
     uint32_t state_;
@@ -81,16 +121,87 @@ inline int getTypeSize(SCTypeCode type) {
     }
 }
 
+// SCBlockData - payload bytes of an SCBlock.
+// Normally a view into the decrypted save buffer the block was parsed from
+// (no per-block allocation), so that buffer must outlive the block. Copies
+// into its own storage when resized, so a block can still grow or shrink
+// without touching the shared buffer.
+// Moving keeps the view; copying always makes an owned deep copy, so a
+// copied block never aliases the buffer and outlives it safely.
+class SCBlockData {
+public:
+    SCBlockData() = default;
+    SCBlockData(const SCBlockData& o) { *this = o; }
+    SCBlockData(SCBlockData&& o) noexcept = default;
+    SCBlockData& operator=(SCBlockData&& o) noexcept = default;
+    SCBlockData& operator=(const SCBlockData& o) {
+        if (this == &o)
+            return *this;
+        owned_.assign(o.ptr_, o.ptr_ + o.size_);
+        isOwned_ = true;
+        ptr_ = owned_.data();
+        size_ = o.size_;
+        return *this;
+    }
+
+    // Point at size bytes of an external buffer that outlives this block.
+    void setView(uint8_t* ptr, size_t size) {
+        owned_.clear();
+        owned_.shrink_to_fit();
+        isOwned_ = false;
+        ptr_ = ptr;
+        size_ = size;
+    }
+
+    // Change the payload size, detaching from the shared buffer.
+    // Existing bytes are kept, new bytes are zero-filled.
+    void resize(size_t size) {
+        if (size == size_)
+            return;
+        if (!isOwned_) {
+            owned_.assign(ptr_, ptr_ + std::min(size, size_));
+            isOwned_ = true;
+        }
+        owned_.resize(size, 0);
+        ptr_ = owned_.data();
+        size_ = size;
+    }
+
+    uint8_t* data() { return ptr_; }
+    const uint8_t* data() const { return ptr_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool isOwned() const { return isOwned_; }
+
+    uint8_t& operator[](size_t i) { return ptr_[i]; }
+    uint8_t operator[](size_t i) const { return ptr_[i]; }
+
+    uint8_t* begin() { return ptr_; }
+    uint8_t* end() { return ptr_ + size_; }
+    const uint8_t* begin() const { return ptr_; }
+    const uint8_t* end() const { return ptr_ + size_; }
+
+private:
+    uint8_t* ptr_ = nullptr;
+    size_t size_ = 0;
+    bool isOwned_ = false;
+    std::vector<uint8_t> owned_;
+};
+
 // SCBlock - a single data block from the save file.
 // From PKHeX.Core/Saves/Encryption/SwishCrypto/SCBlock.cs
 struct SCBlock {
     uint32_t key;
     SCTypeCode type;
     SCTypeCode subType = SCTypeCode::None;
-    std::vector<uint8_t> data;
+    SCBlockData data;
 
-    // Parse one block from XOR-decrypted data. Advances offset.
-    static SCBlock readFromOffset(const uint8_t* buf, size_t bufLen, size_t& offset);
+    // Parse one block from static-xorpad-decrypted data into block. Advances
+    // offset. The payload is XorShift-decrypted in place and data becomes a
+    // view into buf, so buf must outlive the block. Returns false, without
+    // touching anything past bufLen, if the block is truncated, has a
+    // negative length or an unknown type.
+    static bool readFromOffset(uint8_t* buf, size_t bufLen, size_t& offset, SCBlock& block);
 
     // Write block back (encrypted) into output buffer. Returns bytes written.
     size_t writeBlock(uint8_t* out) const;
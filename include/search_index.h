@@ -0,0 +1,85 @@
+#pragma once
+#include "pokemon.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Search criteria in index terms (see SearchIndex::scan).
+// Text fields are expected lowercase; empty means "any".
+struct SearchQuery {
+    uint16_t speciesId = 0;       // exact national dex ID (0 = any)
+    std::string speciesName;      // substring of the species name (when speciesId == 0)
+    std::string otName;           // substring of the OT name
+    bool shiny = false;
+    bool egg   = false;
+    bool alpha = false;
+    int  gender = -1;             // 0 = male, 1 = female, 2 = genderless, -1 = any
+    int  levelMin = 0;            // 0 = no bound; not applied to eggs
+    int  levelMax = 0;
+    int  minPerfectIVs = 0;       // number of IVs that must be 31
+    bool hasRibbon = false;       // at least one ribbon (not a mark)
+    bool hasMark   = false;       // at least one mark
+    bool hasAny    = false;       // at least one ribbon or mark
+};
+
+// SearchIndex - searchable attributes of every slot in a container (save or
+// bank), one packed column per attribute, indexed by flat slot number
+// (box * slotsPerBox + slot). Rows are decoded once from the Pokemon when
+// set; scan() then filters on the columns without touching Pokemon data.
+class SearchIndex {
+public:
+    // Drop all rows and size the index for `slotCount` slots (unbuilt).
+    void reset(int slotCount);
+
+    // The owner fills every row with set() and then marks the index built.
+    // Until then it keeps no rows up to date.
+    bool built() const { return built_; }
+    void markBuilt() { built_ = true; }
+
+    void set(int idx, const Pokemon& pkm);
+    void clear(int idx);
+
+    int size() const { return static_cast<int>(flags_.size()); }
+
+    bool     occupied(int idx)   const { return flags_[idx] & FLAG_OCCUPIED; }
+    bool     isShiny(int idx)    const { return flags_[idx] & FLAG_SHINY; }
+    bool     isEgg(int idx)      const { return flags_[idx] & FLAG_EGG; }
+    bool     isAlpha(int idx)    const { return flags_[idx] & FLAG_ALPHA; }
+    uint16_t species(int idx)    const { return species_[idx]; }
+    uint8_t  form(int idx)       const { return form_[idx]; }
+    uint8_t  level(int idx)      const { return level_[idx]; }
+    uint8_t  gender(int idx)     const { return gender_[idx]; }
+    const std::string& otName(int idx) const { return otName_[idx]; }
+
+    // Append the flat index of every matching slot to `out`, in slot order.
+    void scan(const SearchQuery& q, std::vector<int>& out) const;
+
+    // Persisted copy of a built index (a bank's summary file). `stamp`
+    // identifies the data it was built from; readFile() fails on a mismatch
+    // and leaves the index unbuilt.
+    bool writeFile(const std::string& path, uint64_t stamp) const;
+    bool readFile(const std::string& path, uint64_t stamp);
+
+private:
+    static constexpr uint8_t FLAG_OCCUPIED = 0x01;
+    static constexpr uint8_t FLAG_SHINY    = 0x02;
+    static constexpr uint8_t FLAG_EGG      = 0x04;
+    static constexpr uint8_t FLAG_ALPHA    = 0x08;
+    static constexpr uint8_t FLAG_RIBBON   = 0x10;
+    static constexpr uint8_t FLAG_MARK     = 0x20;
+
+    // Summary file: [8] magic, [4] version, [8] stamp, [4] slot count,
+    // [4] row count, then one row per occupied slot.
+    static constexpr char FILE_MAGIC[8] = {'P','K','H','I','D','X','\0','\0'};
+    static constexpr uint32_t FILE_VERSION = 1;
+
+    bool built_ = false;
+    std::vector<uint8_t>  flags_;
+    std::vector<uint16_t> species_;
+    std::vector<uint8_t>  form_;
+    std::vector<uint8_t>  level_;
+    std::vector<uint8_t>  gender_;
+    std::vector<uint8_t>  perfectIVs_;
+    std::vector<std::string> otName_;       // as displayed
+    std::vector<std::string> otNameLower_;  // for substring matching
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// A sprite to draw: a texture plus the rectangle to copy from it.
+// Atlas sprites share one page texture; loose PNGs use their whole texture.
+struct SpriteRef {
+    SDL_Texture* tex = nullptr;
+    SDL_Rect     src{};
+    explicit operator bool() const { return tex != nullptr; }
+};
+
+// Pre-decoded sprite atlas written by tools/pack_sprite_atlas.py.
+// load() uploads every page once; find() is a binary search over the
+// (species, form) index, so drawing never decodes a PNG.
+class SpriteAtlas {
+public:
+    bool load(const std::string& path, SDL_Renderer* renderer);
+    void free();
+    bool loaded() const { return !pages_.empty(); }
+
+    // Form-specific sprite if packed, else the base form; empty if neither.
+    SpriteRef find(uint16_t species, uint8_t form) const;
+
+private:
+    struct Entry {
+        uint32_t key;   // species << 8 | form, the index sort order
+        uint8_t  page;
+        SDL_Rect rect;
+    };
+    std::vector<SDL_Texture*> pages_;
+    std::vector<Entry> entries_;
+    const Entry* lookup(uint32_t key) const;
+};
@@ -2,21 +2,47 @@
 #include "sc_block.h"
 #include <vector>
 #include <cstdint>
+#include <utility>
 
 // SwishCrypto - save file encryption/decryption for Gen8+ Pokemon games.
 // Ported from PKHeX.Core/Saves/Encryption/SwishCrypto/SwishCrypto.cs
 namespace SwishCrypto {
 
     // XOR the data in-place with the repeating 127-byte static xorpad.
-    void cryptStaticXorpadBytes(uint8_t* data, size_t len);
+    // padOffset is data's position within the save payload, so a sub-range
+    // can be re-crypted on its own.
+    void cryptStaticXorpadBytes(uint8_t* data, size_t len, size_t padOffset = 0);
 
     // Decrypt a save file into SCBlocks.
-    // Modifies fileData in-place (XOR step), then parses blocks.
-    std::vector<SCBlock> decrypt(uint8_t* fileData, size_t fileSize);
+    // Decrypts fileData in-place (static xorpad, then each block's payload)
+    // and fills blocks with views that point into it, so fileData must
+    // stay alive and unmoved for as long as the blocks are used.
+    // Returns false (and no blocks) if the file is truncated or corrupt;
+    // fileData is then partly decrypted and must be discarded.
+    bool decrypt(uint8_t* fileData, size_t fileSize, std::vector<SCBlock>& blocks);
 
     // Encrypt SCBlocks back into raw save file data.
     std::vector<uint8_t> encrypt(const std::vector<SCBlock>& blocks);
 
+    // Re-encrypt a single block in place inside an already encrypted save
+    // image, at the payload offset it was parsed from. The block's encoded
+    // size must not have changed. Returns bytes written.
+    size_t encryptBlockAt(const SCBlock& block, uint8_t* fileData, size_t offset);
+
+    // Recompute the trailing SHA256 of an encrypted save image in place.
+    void writeHash(uint8_t* fileData, size_t fileSize);
+
+    // Size of the trailing SHA256 hash.
+    constexpr size_t HASH_SIZE = 32;
+
+    // Plain SHA256 of the concatenated parts, each passed to the hasher as a
+    // separate update, with the same backend as the save hash (self-tests).
+    void sha256(const std::vector<std::pair<const uint8_t*, size_t>>& parts,
+                uint8_t out[HASH_SIZE]);
+
+    // SHA256 backend compiled in: "armv8", "sha-ni" or "portable".
+    const char* sha256Backend();
+
     // Find a block by key (linear search).
     SCBlock* findBlock(std::vector<SCBlock>& blocks, uint32_t key);
     const SCBlock* findBlock(const std::vector<SCBlock>& blocks, uint32_t key);
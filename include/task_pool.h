@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// TaskPool - worker threads for CPU-bound batch work (decrypting boxes,
+// building summaries) on the cores the main thread isn't using.
+//
+// parallelFor() splits an index range into one contiguous share per
+// participant (the workers plus the calling thread). Each takes items from
+// the front of its own share and, once that runs out, steals single items
+// from the others, so an uneven split still finishes together. Every index
+// is run exactly once; callers that write results into slot `i` of a
+// pre-sized array get them in index order regardless of scheduling.
+class TaskPool {
+public:
+    // Shared pool sized to the machine: two workers on the Switch (cores 1
+    // and 2, next to the main thread on core 0), hardware threads - 1 elsewhere.
+    static TaskPool& shared();
+
+    explicit TaskPool(int workers);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Number of threads that take part in parallelFor(), caller included.
+    int concurrency() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // Run fn(i) for every i in [0, count) and return when all are done.
+    // fn runs concurrently on several threads. Safe to call from several
+    // threads at once (the UI thread and a background scan can both build
+    // summaries): callers take the pool one job at a time, so a second
+    // caller waits for the first job to finish. Not reentrant: fn must not
+    // call parallelFor() on the same pool.
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+private:
+    // One participant's share of the current job, on its own cache line so
+    // the owner and thieves don't false-share with neighbours
+    struct alignas(64) Share {
+        std::atomic<int> next{0};
+        int end = 0;
+    };
+
+    void workerMain(int index);
+    void runShares(int self);
+
+    std::vector<std::thread> workers_;
+    std::unique_ptr<Share[]> shares_;
+
+    std::mutex callMutex_;  // held by the caller for a whole job
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(int)>* job_ = nullptr;
+    unsigned generation_ = 0;
+    int running_ = 0;      // workers still inside the current job
+    bool stopping_ = false;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// TextureCache - one LRU cache for the UI's on-demand sprite textures
+// (ribbons, balls, type icons, loose Pokemon sprites).
+//
+// Entries are charged w * h * 4 bytes. When an insert takes the total over
+// the budget, least recently used textures are destroyed until it fits
+// again; the texture just inserted is never the one evicted. Failed loads
+// are remembered as null entries that cost nothing, so a missing file is
+// only tried once.
+class TextureCache {
+public:
+    using Loader = std::function<SDL_Texture*()>;
+
+    struct Stats {
+        size_t   bytes     = 0;  // currently resident
+        size_t   budget    = 0;
+        size_t   textures  = 0;  // resident, non-null
+        uint64_t evictions = 0;  // since startup
+    };
+
+    explicit TextureCache(size_t budgetBytes) : budget_(budgetBytes) {}
+    ~TextureCache() { clear(); }
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // Cached texture for key, or load() it, cache it and return it (may be
+    // null). Draw it before fetching many more: a later get() can evict it.
+    SDL_Texture* get(const std::string& key, const Loader& load);
+
+    void clear();
+    Stats stats() const;
+
+private:
+    struct Entry {
+        SDL_Texture* tex;
+        size_t       bytes;
+        std::list<std::string>::iterator lru;
+    };
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_;   // front = most recently used
+    size_t   budget_;
+    size_t   bytes_     = 0;
+    size_t   textures_  = 0;
+    uint64_t evictions_ = 0;
+
+    void evictToBudget(const std::string& keep);
+};
@@ -5,14 +5,20 @@
 #include "account.h"
 #include "theme.h"
 #include "wondercard.h"
+#include "sprite_atlas.h"
+#include "texture_cache.h"
+#include "glyph_font.h"
+#include "profiler.h"
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_image.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <unordered_set>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 // Which panel the cursor is on
 enum class Panel { Game, Bank };
@@ -60,6 +66,10 @@ struct SearchResult {
     bool isAlpha;
     uint8_t gender;
     std::string otName;
+    // Global search hit in a bank that isn't open (empty for open panels)
+    std::string bankName;
+    std::string bankPath;
+    GameType bankGame = GameType::ZA;
 };
 
 // Cursor position within the two-panel display
@@ -90,50 +100,24 @@ private:
     SDL_Window*          window_    = nullptr;
     SDL_Renderer*        renderer_  = nullptr;
     SDL_GameController*  pad_       = nullptr;
-    TTF_Font*            font_      = nullptr;
-    TTF_Font*            fontSmall_ = nullptr;
-    TTF_Font*            fontLarge_ = nullptr;
-
-    // Sprite cache: (national dex ID | form << 16) -> texture
-    std::unordered_map<uint32_t, SDL_Texture*> spriteCache_;
-    std::unordered_map<uint32_t, SDL_Texture*> shinySpriteCache_;
-
-    // Ribbon sprite cache: filename -> texture
-    std::unordered_map<std::string, SDL_Texture*> ribbonSpriteCache_;
+    GlyphFont*           font_      = nullptr;
+    GlyphFont*           fontSmall_ = nullptr;
+    GlyphFont*           fontLarge_ = nullptr;
+
+    // Pokemon sprites come from the packed atlases (romfs:/atlas/), which
+    // stay resident. Everything else loaded on demand - ribbons, balls,
+    // type icons, loose PNGs for sprites the atlas lacks - shares one
+    // byte-budgeted LRU cache.
+    static constexpr size_t TEXTURE_BUDGET = 16 * 1024 * 1024;
+    SpriteAtlas spriteAtlas_;
+    SpriteAtlas shinySpriteAtlas_;
+    TextureCache textureCache_{TEXTURE_BUDGET};
     SDL_Texture* getRibbonSprite(const std::string& filename);
-
-    // Ball sprite cache: ball ID -> texture
-    std::unordered_map<uint8_t, SDL_Texture*> ballSpriteCache_;
     SDL_Texture* getBallSprite(uint8_t ballId);
-
-    // Type icon cache: type ID -> texture
-    std::unordered_map<uint8_t, SDL_Texture*> typeSpriteCache_;
     SDL_Texture* getTypeSprite(uint8_t typeId);
 
-    // Text texture cache: avoids re-rasterising identical strings every frame
-    struct TextCacheKey {
-        std::string text;
-        TTF_Font*   font;
-        uint32_t    colorVal; // packed RGBA
-        bool operator==(const TextCacheKey& o) const {
-            return text == o.text && font == o.font && colorVal == o.colorVal;
-        }
-    };
-    struct TextCacheKeyHash {
-        size_t operator()(const TextCacheKey& k) const {
-            size_t h = std::hash<std::string>{}(k.text);
-            h ^= std::hash<uintptr_t>{}(reinterpret_cast<uintptr_t>(k.font)) + 0x9e3779b9 + (h << 6) + (h >> 2);
-            h ^= std::hash<uint32_t>{}(k.colorVal) + 0x9e3779b9 + (h << 6) + (h >> 2);
-            return h;
-        }
-    };
-    struct TextCacheEntry {
-        SDL_Texture* tex;
-        int w, h;
-    };
-    std::unordered_map<TextCacheKey, TextCacheEntry, TextCacheKeyHash> textCache_;
-    const TextCacheEntry& getTextEntry(const std::string& text, TTF_Font* f, SDL_Color color);
-    void clearTextCache();
+    // Text is drawn from per-font glyph atlases (see GlyphFont)
+    TextExtent measureText(const std::string& text, GlyphFont* f) const;
 
     // Status icons
     SDL_Texture* iconShiny_      = nullptr;
@@ -182,7 +166,6 @@ private:
     // Theme
     int themeIndex_ = 0;
     const Theme* theme_ = nullptr;
-    const Theme* lastTheme_ = nullptr; // tracks theme changes for text cache invalidation
     const Theme& T() const { return *theme_; }
 
     // Theme selector state
@@ -264,8 +247,20 @@ private:
     bool allBanksMode_ = false;       // entered bank selector via "View All Banks"
     std::vector<GameType> availableGames_;
     std::unordered_map<GameType, SDL_Texture*> gameIconCache_;
-    std::unordered_map<GameType, int> gameBankCounts_;
-    void refreshBankCounts();
+    std::unordered_map<GameType, int> gameBankCounts_;  // absent = still counting
+
+    // Bank counting runs on a worker thread so the game cards show up at
+    // once. The worker publishes (game, count) pairs; the run loop moves
+    // them into gameBankCounts_ via collectBankCounts().
+    std::thread bankCountWorker_;
+    std::mutex bankCountMutex_;
+    std::vector<std::pair<GameType, int>> bankCountResults_;
+    std::atomic<bool> bankCountCancel_{false};
+    void refreshBankCounts();                // recount every available game
+    void recountBanks(GameType game);        // recount one game (and its pair)
+    void startBankCountScan();               // count games with no count yet
+    void stopBankCountScan();
+    bool collectBankCounts();                // true if any count arrived
     void loadGameIcons();
     void freeGameIcons();
     void enterAllBanksMode();
@@ -330,6 +325,21 @@ private:
     bool dirty_ = true;
     void markDirty() { dirty_ = true; }
 
+    // Diagnostics. L3 toggles the frame-time overlay together with the
+    // Profiler; R3 writes the recorded probes as a Chrome trace next to the
+    // banks. An SDL event filter catches both so they work on every screen.
+    static constexpr int PERF_HISTORY = 120;   // frames in the overlay graph
+    bool     showPerfOverlay_    = false;
+    bool     traceDumpRequested_ = false;
+    float    perfHistory_[PERF_HISTORY] = {};
+    int      perfHistoryPos_     = 0;
+    std::string perfNotice_;
+    uint32_t perfNoticeUntil_    = 0;
+    static int perfEventFilter(void* userdata, SDL_Event* event);
+    void presentFrame();    // overlay + SDL_RenderPresent + Profiler::frameMark
+    void dumpTrace();
+    void drawPerfOverlay();
+
     // Main view state
     Cursor cursor_;
     int    gameBox_ = 0;
@@ -380,8 +390,9 @@ private:
     static constexpr uint32_t DOUBLE_TAP_MS = 300;
 
     // Sprites
-    SDL_Texture* getSprite(uint16_t nationalId, uint8_t form = 0);
-    SDL_Texture* getShinySprite(uint16_t nationalId, uint8_t form = 0);
+    SpriteRef getSprite(uint16_t nationalId, uint8_t form = 0);
+    SpriteRef getShinySprite(uint16_t nationalId, uint8_t form = 0);
+    void loadSpriteAtlases();
     void freeSprites();
 
     // Profile selector
@@ -394,7 +405,22 @@ private:
     void handleGameSelectorInput(bool& running);
     void selectGame(GameType game);
     std::string buildBackupDir(GameType game) const;
-    bool saveBankFiles();
+
+    // Save pipeline. The steps run in order on a worker thread while the main
+    // thread keeps drawing a progress card and discards input; nothing else
+    // touches save_/bank_ until runSaveSteps() returns.
+    struct SaveStep {
+        const char* label;          // StrKey shown while the step runs
+        std::function<void()> run;
+    };
+    void runSaveSteps(const std::vector<SaveStep>& steps);
+    void drawWorkingCard(const std::string& msg, double spin, float progress);
+    // Bank steps set bankFailed when a bank could not be written
+    void addBankSaveSteps(std::vector<SaveStep>& steps, bool& bankFailed);
+    bool saveBankFiles();           // open bank(s) only
+    bool saveAllFiles();            // bank(s), then the game save and commit
+    bool bankReadErrorShown_ = false;
+    void reportBankReadError();     // once per failing bank load
 
     // Bank selector
     void drawBankSelectorFrame();
@@ -426,8 +452,8 @@ private:
                    Panel panelId);
     void drawSlot(int x, int y, const SlotDisplay& sd, bool isCursor, int selectOrder,
                   int highlightState = 0, bool isParty = false);
-    void drawText(const std::string& text, int x, int y, SDL_Color color, TTF_Font* f);
-    void drawTextCentered(const std::string& text, int cx, int cy, SDL_Color color, TTF_Font* f);
+    void drawText(const std::string& text, int x, int y, SDL_Color color, GlyphFont* f);
+    void drawTextCentered(const std::string& text, int cx, int cy, SDL_Color color, GlyphFont* f);
     void drawRect(int x, int y, int w, int h, SDL_Color color);
     void drawRectOutline(int x, int y, int w, int h, SDL_Color color, int thickness);
     void drawStatusBar(const std::string& msg);
@@ -460,8 +486,25 @@ private:
     void injectWondercard(const WCInfo& info);
     std::string exportPokemon(const Pokemon& pkm);
     void executeSearch();
-    bool matchesSearchFilter(const Pokemon& pkm, const std::string& filterSpecies,
-                             const std::string& filterOT) const;
+    SearchQuery buildSearchQuery() const;
+    void scanSearchResults();  // append matches from both panels to searchResults_
+    // All-banks list searches also cover banks that aren't open. Reading
+    // (or rebuilding) their .idx summaries runs on a worker thread, like the
+    // bank counts; the run loop merges each bank's matches into
+    // searchResults_ via collectDiskSearch() while the results popup shows
+    // progress. Closing the popup or starting a new search cancels it.
+    std::thread diskSearchWorker_;
+    std::mutex diskSearchMutex_;
+    std::vector<SearchResult> diskSearchResults_;
+    std::atomic<bool> diskSearchCancel_{false};
+    std::atomic<bool> diskSearchRunning_{false};
+    std::atomic<int> diskSearchDone_{0};   // banks finished
+    std::atomic<int> diskSearchTotal_{0};  // banks to search, 0 until listed
+    int diskSearchSeen_ = 0;               // last diskSearchDone_ drawn
+    void scanDiskBanks();      // start matching every other bank on disk
+    void stopDiskSearch();
+    bool collectDiskSearch();  // true if results or progress arrived
+    bool openResultBank(const SearchResult& r);
     bool isSearchMatch(Panel panel, int box, int slot) const;
     void clearSearchHighlight();
     void refreshHighlightSet();
@@ -477,5 +520,6 @@ private:
     // Get pokemon at cursor from the appropriate source
     Pokemon getPokemonAt(int box, int slot, Panel panel) const;
     void setPokemonAt(int box, int slot, Panel panel, const Pokemon& pkm);
+    void setPokemonBatch(Panel panel, const std::vector<SaveFile::BoxSlotWrite>& writes);
     void clearPokemonAt(int box, int slot, Panel panel);
 };
@@ -1,23 +1,71 @@
 #include "bank.h"
+#include "task_pool.h"
+#include "profiler.h"
 #include <fstream>
+#include <cstdio>
 #include <cstring>
+#include <sys/stat.h>
 
 Bank::Bank() {
-    slots_.resize(boxCount_ * slotsPerBox_);
+    boxData_.resize(boxCount_);
     boxNames_.resize(boxCount_);
+    slotDirty_.resize(totalSlots());
+    nameDirty_.resize(boxNames_.size());
 }
 
 void Bank::setGameType(GameType g) {
     gameType_ = g;
+    searchIndex_.reset(0); // attributes decode differently per game
     auto& info   = gameInfo(g);
+    int oldTotal = totalSlots();
+    int oldSlotSize = slotSize_;
+
+    if (info.boxCount == boxCount_ && info.slotsPerBox == slotsPerBox_
+        && info.bankSlotSize == oldSlotSize)
+        return;
+
+    // Layout changes: pull every stored slot in under the old layout, then
+    // repack them in order into the new one. Nothing is left to read from
+    // the file. Boxes never read from a bank without a file are empty.
+    if (!sourcePath_.empty())
+        loadAllBoxes();
+    bool hasData = residentBoxCount() > 0;
+    std::vector<uint8_t> flat;
+    if (hasData) {
+        flat.resize((size_t)oldTotal * oldSlotSize, 0);
+        size_t oldBoxBytes = flat.size() / boxData_.size();
+        for (size_t b = 0; b < boxData_.size(); b++) {
+            if (!boxData_[b].empty())
+                std::memcpy(flat.data() + b * oldBoxBytes, boxData_[b].data(), oldBoxBytes);
+        }
+    }
+
     boxCount_    = info.boxCount;
     slotsPerBox_ = info.slotsPerBox;
     slotSize_    = info.bankSlotSize;
-    slots_.resize(boxCount_ * slotsPerBox_);
+    boxData_.assign(boxCount_, {});
+    sourcePath_.clear();
+
+    if (hasData) {
+        int copyLen = std::min(oldSlotSize, slotSize_);
+        for (int i = 0; i < std::min(oldTotal, totalSlots()); i++)
+            std::memcpy(slotBytes(i), flat.data() + (size_t)i * oldSlotSize, copyLen);
+        occupied_ = -1;
+    }
+
     boxNames_.resize(boxCount_);
+    slotDirty_.resize(totalSlots());
+    nameDirty_.resize(boxNames_.size());
+
+    // A different layout no longer matches the file on disk
+    cleanPath_.clear();
 }
 
 bool Bank::load(const std::string& path) {
+    Profiler::Scope probe(ProfZone::BankLoad);
+    // Nothing on disk is known to match until a load succeeds
+    cleanPath_.clear();
+
     std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
         // File doesn't exist - start with empty bank
@@ -37,61 +85,176 @@ bool Bank::load(const std::string& path) {
     int fileBoxCount;
     int fileSlotSize;
     int fileSlotsPerBox;
-    if (version == VERSION_FRLG) {
-        fileBoxCount = 14;
-        fileSlotSize = PokeCrypto::SIZE_3STORED;
-        fileSlotsPerBox = 30;
-    } else if (version == VERSION_LGPE) {
-        fileBoxCount = 40;
-        fileSlotSize = PokeCrypto::SIZE_6PARTY;
-        fileSlotsPerBox = 25;
-    } else if (version == VERSION_LA) {
-        fileBoxCount = 32;
-        fileSlotSize = PokeCrypto::SIZE_8APARTY;
-        fileSlotsPerBox = 30;
-    } else if (version == VERSION_40BOX) {
-        fileBoxCount = 40;
-        fileSlotSize = PokeCrypto::SIZE_9PARTY;
-        fileSlotsPerBox = 30;
-    } else if (version == VERSION_32BOX) {
-        fileBoxCount = 32;
-        fileSlotSize = PokeCrypto::SIZE_9PARTY;
-        fileSlotsPerBox = 30;
-    } else {
+    if (!layoutFor(version, fileBoxCount, fileSlotSize, fileSlotsPerBox))
         return false; // Unsupported version
-    }
+
+    uint32_t occupancy = 0;
+    file.read(reinterpret_cast<char*>(&occupancy), 4);
 
     // Use the file's parameters
     boxCount_ = fileBoxCount;
     slotSize_ = fileSlotSize;
     slotsPerBox_ = fileSlotsPerBox;
-    slots_.resize(boxCount_ * slotsPerBox_);
-
-    // Skip reserved
-    file.seekg(HEADER_SIZE);
 
-    // Read all slots (decrypted data)
-    int total = totalSlots();
-    for (int i = 0; i < total; i++) {
-        file.read(reinterpret_cast<char*>(slots_[i].data.data()), slotSize_);
-    }
+    // Slots stay on disk until a box is first accessed
+    boxData_.assign(boxCount_, {});
+    searchIndex_.reset(0);
+    sourcePath_ = path;
+    sourceError_ = false;
+    occupied_ = (occupancy & OCCUPANCY_VALID) ? (int)(occupancy & ~OCCUPANCY_VALID) : -1;
 
     // Read box names if present (appended after slot data)
-    boxNames_.resize(boxCount_);
+    file.seekg(namesOffset());
+    boxNames_.assign(boxCount_, std::string());
+    bool hasAllNames = true;
     for (int i = 0; i < boxCount_; i++) {
         char nameBuf[BOX_NAME_SIZE] = {};
-        if (!file.read(nameBuf, BOX_NAME_SIZE))
+        if (!file.read(nameBuf, BOX_NAME_SIZE)) {
+            hasAllNames = false;
             break; // Old file without names — leave remaining as empty
+        }
         // Find null terminator or use full buffer
         int len = 0;
         while (len < BOX_NAME_SIZE && nameBuf[len] != '\0') len++;
         boxNames_[i] = std::string(nameBuf, len);
     }
 
+    // Save generation follows the names (older files end before it)
+    generation_ = 0;
+    if (hasAllNames && !file.read(reinterpret_cast<char*>(&generation_), GENERATION_SIZE))
+        generation_ = 0;
+
+    markAllClean(path);
+    cleanVersion_ = version;
+    // Old files without a full name table get rewritten whole on next save
+    if (!hasAllNames)
+        cleanPath_.clear();
+
     return true;
 }
 
+uint8_t* Bank::ensureBox(int box) const {
+    auto& data = boxData_[box];
+    if (!data.empty())
+        return data.data();
+
+    size_t boxBytes = (size_t)slotsPerBox_ * slotSize_;
+    data.assign(boxBytes, 0);
+    if (sourcePath_.empty())
+        return data.data();
+
+    // Missing or short data reads as empty slots, as a full load would
+    Profiler::Scope probe(ProfZone::BankLoad);
+    std::ifstream file(sourcePath_, std::ios::binary);
+    if (!file.is_open()) {
+        sourceError_ = true;
+        return data.data();
+    }
+    file.seekg(HEADER_SIZE + (std::streamoff)box * boxBytes);
+    file.read(reinterpret_cast<char*>(data.data()), boxBytes);
+    return data.data();
+}
+
+uint8_t* Bank::slotBytes(int idx) const {
+    return ensureBox(idx / slotsPerBox_) + (size_t)(idx % slotsPerBox_) * slotSize_;
+}
+
+void Bank::loadAllBoxes() const {
+    for (int box = 0; box < boxCount_; box++)
+        ensureBox(box);
+}
+
+int Bank::residentBoxCount() const {
+    int count = 0;
+    for (auto& box : boxData_)
+        if (!box.empty())
+            count++;
+    return count;
+}
+
+void Bank::markAllClean(const std::string& path) {
+    slotDirty_.assign(totalSlots(), 0);
+    nameDirty_.assign(boxNames_.size(), 0);
+    cleanPath_ = path;
+    cleanVersion_ = fileVersion();
+}
+
 bool Bank::save(const std::string& path) {
+    Profiler::Scope probe(ProfZone::BankSave);
+    generation_++;
+    bool ok;
+    if (path == cleanPath_ && fileVersion() == cleanVersion_)
+        ok = savePartial(path);
+    else
+        ok = saveFull(path);
+
+    if (ok) {
+        markAllClean(path);
+        // Keep the summary in step with the file, or drop it so the next
+        // bank-wide search rebuilds it
+        uint64_t stamp = fileStamp(path);
+        if (!searchIndex_.built() || !stamp || !searchIndex_.writeFile(indexPathFor(path), stamp))
+            std::remove(indexPathFor(path).c_str());
+    } else {
+        cleanPath_.clear(); // file state unknown, rewrite it all next time
+    }
+    return ok;
+}
+
+bool Bank::savePartial(const std::string& path) {
+    // Rewrite only changed slot runs and box names, in place. An interrupted
+    // write can only affect those ranges, never the rest of the bank.
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open())
+        return saveFull(path);
+
+    int total = totalSlots();
+    for (int i = 0; i < total; ) {
+        if (!slotDirty_[i]) {
+            i++;
+            continue;
+        }
+        // Coalesce a run of adjacent dirty slots into one write
+        int end = i;
+        while (end < total && slotDirty_[end])
+            end++;
+        file.seekp(HEADER_SIZE + (std::streamoff)i * slotSize_);
+        for (int j = i; j < end; j++)
+            file.write(reinterpret_cast<const char*>(slotBytes(j)), slotSize_);
+        i = end;
+    }
+
+    std::streamoff namesOfs = namesOffset();
+    for (int i = 0; i < boxCount_; i++) {
+        if (!nameDirty_[i])
+            continue;
+        char nameBuf[BOX_NAME_SIZE] = {};
+        std::memcpy(nameBuf, boxNames_[i].c_str(),
+                    std::min((int)boxNames_[i].size(), BOX_NAME_SIZE));
+        file.seekp(namesOfs + (std::streamoff)i * BOX_NAME_SIZE);
+        file.write(nameBuf, BOX_NAME_SIZE);
+    }
+
+    // Keep the header occupancy index in sync with the rewritten slots
+    uint32_t occupancy = OCCUPANCY_VALID | static_cast<uint32_t>(occupiedCount());
+    file.seekp(OCCUPANCY_OFFSET);
+    file.write(reinterpret_cast<const char*>(&occupancy), 4);
+
+    // New generation (appended to files written before it existed)
+    file.seekp(namesOfs + (std::streamoff)boxCount_ * BOX_NAME_SIZE);
+    file.write(reinterpret_cast<const char*>(&generation_), GENERATION_SIZE);
+
+    file.flush();
+    return file.good();
+}
+
+bool Bank::saveFull(const std::string& path) {
+    // Every box has to be in memory before the file (possibly the source
+    // itself) is truncated. Never write boxes that could not be read back.
+    loadAllBoxes();
+    if (sourceError_)
+        return false;
+
     std::ofstream file(path, std::ios::binary);
     if (!file.is_open())
         return false;
@@ -100,14 +263,12 @@ bool Bank::save(const std::string& path) {
     file.write(MAGIC, 8);
     uint32_t ver = fileVersion();
     file.write(reinterpret_cast<const char*>(&ver), 4);
-    uint32_t reserved = 0;
-    file.write(reinterpret_cast<const char*>(&reserved), 4);
+    uint32_t occupancy = OCCUPANCY_VALID | static_cast<uint32_t>(occupiedCount());
+    file.write(reinterpret_cast<const char*>(&occupancy), 4);
 
     // Write all slots
-    int total = totalSlots();
-    for (int i = 0; i < total; i++) {
-        file.write(reinterpret_cast<const char*>(slots_[i].data.data()), slotSize_);
-    }
+    for (auto& box : boxData_)
+        file.write(reinterpret_cast<const char*>(box.data()), box.size());
 
     // Write box names (16 bytes each, null-padded)
     for (int i = 0; i < boxCount_; i++) {
@@ -118,7 +279,61 @@ bool Bank::save(const std::string& path) {
         }
         file.write(nameBuf, BOX_NAME_SIZE);
     }
+    file.write(reinterpret_cast<const char*>(&generation_), GENERATION_SIZE);
 
+    if (!file.good())
+        return false;
+
+    // The file now holds everything; later box reads come from it
+    sourcePath_ = path;
+    return true;
+}
+
+bool Bank::isSlotEmpty(int idx) const {
+    return getSlot(idx / slotsPerBox_, idx % slotsPerBox_).isEmpty();
+}
+
+int Bank::occupiedCount() const {
+    if (occupied_ < 0) {
+        int count = 0;
+        int total = totalSlots();
+        for (int i = 0; i < total; i++) {
+            if (!isSlotEmpty(i))
+                count++;
+        }
+        occupied_ = count;
+    }
+    return occupied_;
+}
+
+int Bank::readOccupancyIndex(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return -1;
+
+    char header[HEADER_SIZE];
+    if (!file.read(header, HEADER_SIZE) || std::memcmp(header, MAGIC, 8) != 0)
+        return -1;
+
+    uint32_t occupancy;
+    std::memcpy(&occupancy, header + OCCUPANCY_OFFSET, 4);
+    if (!(occupancy & OCCUPANCY_VALID))
+        return -1;
+    return static_cast<int>(occupancy & ~OCCUPANCY_VALID);
+}
+
+bool Bank::writeOccupancyIndex(const std::string& path, int count) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open())
+        return false;
+
+    char magic[8];
+    if (!file.read(magic, 8) || std::memcmp(magic, MAGIC, 8) != 0)
+        return false;
+
+    uint32_t occupancy = OCCUPANCY_VALID | static_cast<uint32_t>(count);
+    file.seekp(OCCUPANCY_OFFSET);
+    file.write(reinterpret_cast<const char*>(&occupancy), 4);
     return file.good();
 }
 
@@ -126,7 +341,8 @@ Pokemon Bank::getSlot(int box, int slot) const {
     int idx = slotIndex(box, slot);
     if (idx < 0 || idx >= totalSlots())
         return Pokemon{};
-    Pokemon pkm = slots_[idx];
+    Pokemon pkm;
+    std::memcpy(pkm.data.data(), slotBytes(idx), slotSize_);
     pkm.gameType_ = gameType_;
     return pkm;
 }
@@ -135,14 +351,88 @@ void Bank::setSlot(int box, int slot, const Pokemon& pkm) {
     int idx = slotIndex(box, slot);
     if (idx < 0 || idx >= totalSlots())
         return;
-    slots_[idx] = pkm;
+    bool wasEmpty = isSlotEmpty(idx);
+    std::memcpy(slotBytes(idx), pkm.data.data(), slotSize_);
+    if (occupied_ >= 0)
+        occupied_ += (int)wasEmpty - (int)isSlotEmpty(idx);
+    if (searchIndex_.built())
+        searchIndex_.set(idx, getSlot(box, slot));
+    slotDirty_[idx] = 1;
 }
 
 void Bank::clearSlot(int box, int slot) {
     int idx = slotIndex(box, slot);
     if (idx < 0 || idx >= totalSlots())
         return;
-    slots_[idx] = Pokemon{};
+    if (occupied_ >= 0 && !isSlotEmpty(idx))
+        occupied_--;
+    std::memset(slotBytes(idx), 0, slotSize_);
+    searchIndex_.clear(idx);
+    slotDirty_[idx] = 1;
+}
+
+const SearchIndex& Bank::searchIndex() const {
+    if (!searchIndex_.built()) {
+        searchIndex_.reset(totalSlots());
+        // Read every box up front so getSlot() doesn't touch boxData_ from
+        // the pool's threads, then summarize one box per task
+        loadAllBoxes();
+        TaskPool::shared().parallelFor(boxCount_, [this](int box) {
+            for (int s = 0; s < slotsPerBox_; s++)
+                searchIndex_.set(box * slotsPerBox_ + s, getSlot(box, s));
+        });
+        searchIndex_.markBuilt();
+    }
+    return searchIndex_;
+}
+
+std::string Bank::indexPathFor(const std::string& bankPath) {
+    std::string base = bankPath;
+    if (base.size() >= 4 && base.compare(base.size() - 4, 4, ".bin") == 0)
+        base.resize(base.size() - 4);
+    return base + ".idx";
+}
+
+uint64_t Bank::fileStamp(const std::string& bankPath) {
+    struct stat st;
+    if (stat(bankPath.c_str(), &st) != 0)
+        return 0;
+    std::ifstream file(bankPath, std::ios::binary);
+    char header[HEADER_SIZE];
+    if (!file.read(header, HEADER_SIZE) || std::memcmp(header, MAGIC, 8) != 0)
+        return 0;
+    uint32_t version, occupancy;
+    std::memcpy(&version, header + 8, 4);
+    std::memcpy(&occupancy, header + OCCUPANCY_OFFSET, 4);
+
+    // The generation is only there when the file ends right after it
+    uint64_t generation = 0;
+    int boxes, slotSize, slotsPerBox;
+    if (layoutFor(version, boxes, slotSize, slotsPerBox)) {
+        std::streamoff genOfs = HEADER_SIZE + (std::streamoff)boxes * slotsPerBox * slotSize
+                              + (std::streamoff)boxes * BOX_NAME_SIZE;
+        if (st.st_size == genOfs + GENERATION_SIZE) {
+            file.seekg(genOfs);
+            if (!file.read(reinterpret_cast<char*>(&generation), GENERATION_SIZE))
+                generation = 0;
+        }
+    }
+
+    uint64_t stamp = (static_cast<uint64_t>(st.st_mtime) << 32) ^ static_cast<uint64_t>(st.st_size);
+    stamp ^= static_cast<uint64_t>(occupancy) * 0x9E3779B97F4A7C15ull;
+    stamp ^= (generation + 1) * 0xC2B2AE3D27D4EB4Full;
+    return stamp ? stamp : 1;
+}
+
+bool Bank::layoutFor(uint32_t version, int& boxCount, int& slotSize, int& slotsPerBox) {
+    switch (version) {
+        case VERSION_FRLG:  boxCount = 14; slotSize = PokeCrypto::SIZE_3STORED; slotsPerBox = 30; return true;
+        case VERSION_LGPE:  boxCount = 40; slotSize = PokeCrypto::SIZE_6PARTY;  slotsPerBox = 25; return true;
+        case VERSION_LA:    boxCount = 32; slotSize = PokeCrypto::SIZE_8APARTY; slotsPerBox = 30; return true;
+        case VERSION_40BOX: boxCount = 40; slotSize = PokeCrypto::SIZE_9PARTY;  slotsPerBox = 30; return true;
+        case VERSION_32BOX: boxCount = 32; slotSize = PokeCrypto::SIZE_9PARTY;  slotsPerBox = 30; return true;
+        default:            return false;
+    }
 }
 
 std::string Bank::getBoxName(int box) const {
@@ -158,4 +448,5 @@ void Bank::setBoxName(int box, const std::string& name) {
         boxNames_[box] = name.substr(0, BOX_NAME_SIZE);
     else
         boxNames_[box] = name;
+    nameDirty_[box] = 1;
 }
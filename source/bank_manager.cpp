@@ -30,7 +30,12 @@ bool BankManager::init(const std::string& basePath, GameType game) {
 bool BankManager::initAll(const std::string& basePath) {
     basePath_ = basePath;
     allMode_ = true;
-    bankList_.clear();
+    bankList_ = scanAll(basePath);
+    return true;
+}
+
+std::vector<BankInfo> BankManager::scanAll(const std::string& basePath) {
+    std::vector<BankInfo> banks;
 
     // One representative game per unique bank folder (matches game card order)
     constexpr GameType folderGames[] = {
@@ -56,7 +61,7 @@ bool BankManager::initAll(const std::string& basePath) {
             info.fullPath = dir + name;
             info.occupiedSlots = countOccupied(info.fullPath);
             info.game = g;
-            bankList_.push_back(info);
+            banks.push_back(info);
         }
         closedir(d);
     }
@@ -73,7 +78,7 @@ bool BankManager::initAll(const std::string& basePath) {
         if (isFRLG(g)) return 6;
         return 7;
     };
-    std::sort(bankList_.begin(), bankList_.end(), [&](const BankInfo& a, const BankInfo& b) {
+    std::sort(banks.begin(), banks.end(), [&](const BankInfo& a, const BankInfo& b) {
         int oa = gameOrder(a.game), ob = gameOrder(b.game);
         if (oa != ob) return oa < ob;
         std::string la = a.name, lb = b.name;
@@ -82,6 +87,33 @@ bool BankManager::initAll(const std::string& basePath) {
         return la < lb;
     });
 
+    return banks;
+}
+
+bool BankManager::loadSearchIndex(const BankInfo& info, SearchIndex& index) {
+    uint64_t stamp = Bank::fileStamp(info.fullPath);
+    if (!stamp)
+        return false;
+
+    // Nothing to find in an empty bank (count from the header index)
+    if (info.occupiedSlots == 0) {
+        index.reset(0);
+        index.markBuilt();
+        return true;
+    }
+
+    // Fast path: summary written for this exact file contents
+    std::string indexPath = Bank::indexPathFor(info.fullPath);
+    if (index.readFile(indexPath, stamp))
+        return true;
+
+    // Stale or missing: build it from the bank once and store it
+    Bank temp;
+    if (!temp.load(info.fullPath))
+        return false;
+    temp.setGameType(info.game);
+    index = temp.searchIndex();
+    index.writeFile(indexPath, stamp);
     return true;
 }
 
@@ -143,17 +175,19 @@ const std::vector<BankInfo>& BankManager::list() const {
 }
 
 int BankManager::countOccupied(const std::string& filePath) {
+    // Fast path: occupancy index stored in the bank header
+    int indexed = Bank::readOccupancyIndex(filePath);
+    if (indexed >= 0)
+        return indexed;
+
+    // Older file: load it once to count, then store the index so later
+    // listings only read the header
     Bank temp;
     if (!temp.load(filePath))
         return 0;
 
-    int count = 0;
-    for (int box = 0; box < temp.boxCount(); box++) {
-        for (int slot = 0; slot < temp.slotsPerBox(); slot++) {
-            if (!temp.getSlot(box, slot).isEmpty())
-                count++;
-        }
-    }
+    int count = temp.occupiedCount();
+    Bank::writeOccupancyIndex(filePath, count);
     return count;
 }
 
@@ -201,6 +235,7 @@ bool BankManager::deleteBank(const std::string& name) {
 
     if (std::remove(path.c_str()) != 0)
         return false;
+    std::remove(Bank::indexPathFor(path).c_str());
 
     refresh();
     return true;
@@ -224,6 +259,8 @@ bool BankManager::renameBank(const std::string& oldName, const std::string& newN
 
     if (std::rename(oldPath.c_str(), newPath.c_str()) != 0)
         return false;
+    // Renaming keeps the file's stamp, so its summary stays valid
+    std::rename(Bank::indexPathFor(oldPath).c_str(), Bank::indexPathFor(newPath).c_str());
 
     refresh();
     return true;
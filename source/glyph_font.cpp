@@ -0,0 +1,213 @@
+#include "glyph_font.h"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <hb.h>
+#include <hb-ft.h>
+#include <algorithm>
+#include <cstdio>
+
+// One FreeType library for all fonts, released with the last one
+static FT_Library ftLib = nullptr;
+static int ftUsers = 0;
+
+GlyphFont* GlyphFont::fromMemory(SDL_Renderer* renderer, const void* data, size_t size,
+                                 int pixelSize) {
+    GlyphFont* f = new GlyphFont();
+    if (!f->init(renderer, data, size, pixelSize)) {
+        delete f;
+        return nullptr;
+    }
+    return f;
+}
+
+GlyphFont* GlyphFont::fromFile(SDL_Renderer* renderer, const std::string& path,
+                               int pixelSize) {
+    FILE* fp = std::fopen(path.c_str(), "rb");
+    if (!fp)
+        return nullptr;
+    GlyphFont* f = new GlyphFont();
+    std::fseek(fp, 0, SEEK_END);
+    long len = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    if (len > 0) {
+        f->fileData_.resize(len);
+        if (std::fread(f->fileData_.data(), 1, len, fp) != static_cast<size_t>(len))
+            f->fileData_.clear();
+    }
+    std::fclose(fp);
+    if (f->fileData_.empty() ||
+        !f->init(renderer, f->fileData_.data(), f->fileData_.size(), pixelSize)) {
+        delete f;
+        return nullptr;
+    }
+    return f;
+}
+
+bool GlyphFont::init(SDL_Renderer* renderer, const void* data, size_t size, int pixelSize) {
+    renderer_ = renderer;
+    if (!ftLib && FT_Init_FreeType(&ftLib) != 0)
+        return false;
+    ftUsers++;
+
+    if (FT_New_Memory_Face(ftLib, static_cast<const FT_Byte*>(data),
+                           static_cast<FT_Long>(size), 0, &face_) != 0) {
+        face_ = nullptr;
+        return false;
+    }
+    // Same size SDL_ttf used: points at 72 DPI
+    if (FT_Set_Char_Size(face_, 0, pixelSize * 64, 72, 72) != 0)
+        return false;
+    ascent_  = static_cast<int>((face_->size->metrics.ascender + 63) >> 6);
+    descent_ = static_cast<int>(face_->size->metrics.descender >> 6);
+
+    hbFont_ = hb_ft_font_create_referenced(face_);
+    hbBuf_  = hb_buffer_create();
+
+    // Small UI sizes fit comfortably in 512x512; the title size gets 1024
+    atlasSize_ = pixelSize <= 20 ? 512 : 1024;
+    atlas_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32,
+                               SDL_TEXTUREACCESS_STATIC, atlasSize_, atlasSize_);
+    if (!atlas_)
+        return false;
+    SDL_SetTextureBlendMode(atlas_, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+GlyphFont::~GlyphFont() {
+    if (atlas_) SDL_DestroyTexture(atlas_);
+    if (hbBuf_) hb_buffer_destroy(hbBuf_);
+    if (hbFont_) hb_font_destroy(hbFont_);
+    if (face_) FT_Done_Face(face_);
+    if (ftLib && --ftUsers == 0) {
+        FT_Done_FreeType(ftLib);
+        ftLib = nullptr;
+    }
+}
+
+const GlyphFont::ShapedRun& GlyphFont::shape(const std::string& utf8) {
+    auto it = shapeCache_.find(utf8);
+    if (it != shapeCache_.end())
+        return it->second;
+
+    // Layouts are small; dropping them all now and then keeps memory bounded
+    if (shapeCache_.size() >= SHAPE_CACHE_MAX)
+        shapeCache_.clear();
+
+    hb_buffer_clear_contents(hbBuf_);
+    hb_buffer_add_utf8(hbBuf_, utf8.data(), static_cast<int>(utf8.size()), 0, -1);
+    hb_buffer_guess_segment_properties(hbBuf_);
+    hb_shape(hbFont_, hbBuf_, nullptr, 0);
+
+    unsigned int count = 0;
+    const hb_glyph_info_t* info = hb_buffer_get_glyph_infos(hbBuf_, &count);
+    const hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(hbBuf_, &count);
+
+    ShapedRun run;
+    run.glyphs.reserve(count);
+    hb_position_t penX = 0, penY = 0;  // 26.6
+    for (unsigned int i = 0; i < count; i++) {
+        run.glyphs.push_back({info[i].codepoint,
+                              static_cast<int>((penX + pos[i].x_offset + 32) >> 6),
+                              -static_cast<int>((penY + pos[i].y_offset + 32) >> 6)});
+        penX += pos[i].x_advance;
+        penY += pos[i].y_advance;
+    }
+    run.width = static_cast<int>((penX + 63) >> 6);
+    return shapeCache_.emplace(utf8, std::move(run)).first->second;
+}
+
+void GlyphFont::resetAtlas() {
+    slots_.clear();
+    penX_ = penY_ = shelfH_ = 0;
+}
+
+const GlyphFont::AtlasSlot* GlyphFont::glyphSlot(uint32_t gid) {
+    auto it = slots_.find(gid);
+    if (it != slots_.end())
+        return &it->second;
+
+    if (FT_Load_Glyph(face_, gid, FT_LOAD_RENDER) != 0)
+        return nullptr;
+    const FT_GlyphSlot g = face_->glyph;
+    const FT_Bitmap& bm = g->bitmap;
+    int w = static_cast<int>(bm.width);
+    int h = static_cast<int>(bm.rows);
+
+    AtlasSlot slot{{0, 0, 0, 0}, g->bitmap_left, g->bitmap_top};
+    if (w > 0 && h > 0 && bm.pixel_mode == FT_PIXEL_MODE_GRAY) {
+        if (w + 1 > atlasSize_ || h + 1 > atlasSize_)
+            return nullptr;
+        if (penX_ + w + 1 > atlasSize_) {
+            penX_ = 0;
+            penY_ += shelfH_;
+            shelfH_ = 0;
+        }
+        if (penY_ + h + 1 > atlasSize_) {
+            // Queued quads point at the old contents: draw them first
+            flushGeometry();
+            resetAtlas();
+        }
+        slot.rect = {penX_, penY_, w, h};
+        penX_ += w + 1;
+        shelfH_ = std::max(shelfH_, h + 1);
+
+        // Coverage goes in alpha; the vertex colour supplies RGB
+        pixels_.resize(size_t(w) * h * 4);
+        for (int row = 0; row < h; row++) {
+            const uint8_t* src = bm.buffer + row * bm.pitch;
+            uint8_t* dst = pixels_.data() + size_t(row) * w * 4;
+            for (int col = 0; col < w; col++) {
+                dst[col * 4 + 0] = 255;
+                dst[col * 4 + 1] = 255;
+                dst[col * 4 + 2] = 255;
+                dst[col * 4 + 3] = src[col];
+            }
+        }
+        SDL_UpdateTexture(atlas_, &slot.rect, pixels_.data(), w * 4);
+    }
+    return &slots_.emplace(gid, slot).first->second;
+}
+
+TextExtent GlyphFont::measure(const std::string& utf8) {
+    if (utf8.empty())
+        return {};
+    return {shape(utf8).width, height()};
+}
+
+void GlyphFont::flushGeometry() {
+    if (!verts_.empty())
+        SDL_RenderGeometry(renderer_, atlas_, verts_.data(), static_cast<int>(verts_.size()),
+                           indices_.data(), static_cast<int>(indices_.size()));
+    verts_.clear();
+    indices_.clear();
+}
+
+void GlyphFont::draw(const std::string& utf8, int x, int y, SDL_Color color) {
+    if (utf8.empty())
+        return;
+    const ShapedRun& run = shape(utf8);
+
+    // Each glyph's quad is built as soon as its slot is fetched, since the
+    // next fetch may wipe the atlas (flushing the quads queued before it)
+    const float inv = 1.0f / atlasSize_;
+    int baseline = y + ascent_;
+    for (const ShapedGlyph& glyph : run.glyphs) {
+        const AtlasSlot* s = glyphSlot(glyph.gid);
+        if (!s || s->rect.w == 0)
+            continue;
+        float x0 = static_cast<float>(x + glyph.x + s->left);
+        float y0 = static_cast<float>(baseline + glyph.y - s->top);
+        float x1 = x0 + s->rect.w;
+        float y1 = y0 + s->rect.h;
+        float u0 = s->rect.x * inv, v0 = s->rect.y * inv;
+        float u1 = (s->rect.x + s->rect.w) * inv, v1 = (s->rect.y + s->rect.h) * inv;
+
+        int base = static_cast<int>(verts_.size());
+        verts_.push_back({{x0, y0}, color, {u0, v0}});
+        verts_.push_back({{x1, y0}, color, {u1, v0}});
+        verts_.push_back({{x1, y1}, color, {u1, v1}});
+        verts_.push_back({{x0, y1}, color, {u0, v1}});
+        indices_.insert(indices_.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+    flushGeometry();
+}
@@ -1,6 +1,12 @@
 #include "poke_crypto.h"
 #include "binary_io.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // Block shuffle position table (24 patterns * 4 + 8*4 duplicates)
 // From PokeCrypto.cs lines 66-101
 static const uint8_t BLOCK_POSITION[128] = {
@@ -22,10 +28,107 @@ static const uint8_t BLOCK_POSITION_INVERT[32] = {
     0, 1, 2, 4, 3, 5, 6, 7,
 };
 
+// LCG used by the Gen6+ entity cipher: seed = LCG_MUL * seed + LCG_ADD,
+// one step per u16, keyed by the upper 16 bits of the new seed.
+static constexpr uint32_t LCG_MUL = 0x41C64E6D;
+static constexpr uint32_t LCG_ADD = 0x00006073;
+
+// Advancing the LCG n steps is itself an affine map seed -> mul * seed + add
+// (mod 2^32). Lanes can therefore start n steps apart and each jump n steps
+// at once, without a serial chain through every seed.
+struct LcgJump {
+    uint32_t mul;
+    uint32_t add;
+};
+
+static constexpr LcgJump lcgJump(int n) {
+    uint32_t mul = 1, add = 0;
+    for (int i = 0; i < n; i++) {
+        mul *= LCG_MUL;
+        add = add * LCG_MUL + LCG_ADD;
+    }
+    return {mul, add};
+}
+
+// Keys are produced 8 at a time: two vectors of 4 lanes, lane k holding the
+// seed k + 1 steps ahead, all advanced by 8 steps per round.
+static constexpr int    CRYPT_LANES = 8;
+static constexpr LcgJump LCG_JUMP8 = lcgJump(CRYPT_LANES);
+
+#if defined(__SSE2__) && !defined(__ARM_NEON)
+// 32-bit lane multiply (SSE2 only has the 32x32->64 even-lane form)
+static inline __m128i mullo32(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+// XOR len bytes of src with the keystream for seed into dst. src and dst
+// may be the same buffer.
+static void cryptArrayTo(const uint8_t* src, uint8_t* dst, size_t len, uint32_t seed) {
+    size_t pairs = len / 2;
+    size_t i = 0;
+
+#if defined(__ARM_NEON) || defined(__SSE2__)
+    if (pairs >= CRYPT_LANES) {
+        uint32_t lanes[CRYPT_LANES];
+        uint32_t s = seed;
+        for (int k = 0; k < CRYPT_LANES; k++) {
+            s = LCG_MUL * s + LCG_ADD;
+            lanes[k] = s;
+        }
+#if defined(__ARM_NEON)
+        uint32x4_t lo = vld1q_u32(lanes);
+        uint32x4_t hi = vld1q_u32(lanes + 4);
+        const uint32x4_t mul = vdupq_n_u32(LCG_JUMP8.mul);
+        const uint32x4_t add = vdupq_n_u32(LCG_JUMP8.add);
+        for (; i + CRYPT_LANES <= pairs; i += CRYPT_LANES) {
+            uint16x8_t key = vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16));
+            uint8x16_t d = vld1q_u8(src + i * 2);
+            vst1q_u8(dst + i * 2, veorq_u8(d, vreinterpretq_u8_u16(key)));
+            lo = vmlaq_u32(add, lo, mul);
+            hi = vmlaq_u32(add, hi, mul);
+            seed = LCG_JUMP8.mul * seed + LCG_JUMP8.add;
+        }
+#else
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 4));
+        const __m128i mul = _mm_set1_epi32(static_cast<int>(LCG_JUMP8.mul));
+        const __m128i add = _mm_set1_epi32(static_cast<int>(LCG_JUMP8.add));
+        for (; i + CRYPT_LANES <= pairs; i += CRYPT_LANES) {
+            // Arithmetic shift keeps the upper half in int16 range, so the
+            // saturating pack is exact
+            __m128i key = _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_xor_si128(d, key));
+            lo = _mm_add_epi32(mullo32(lo, mul), add);
+            hi = _mm_add_epi32(mullo32(hi, mul), add);
+            seed = LCG_JUMP8.mul * seed + LCG_JUMP8.add;
+        }
+#endif
+    }
+#endif
+
+    // Scalar tail (and the whole array without SIMD)
+    for (; i < pairs; i++) {
+        seed = LCG_MUL * seed + LCG_ADD;
+        uint16_t xorVal = static_cast<uint16_t>(seed >> 16);
+        uint16_t val = readU16LE(src + i * 2);
+        val ^= xorVal;
+        writeU16LE(dst + i * 2, val);
+    }
+}
+
 void PokeCrypto::cryptArray(uint8_t* data, size_t len, uint32_t seed) {
+    cryptArrayTo(data, data, len, seed);
+}
+
+void PokeCrypto::cryptArrayScalar(uint8_t* data, size_t len, uint32_t seed) {
     size_t pairs = len / 2;
     for (size_t i = 0; i < pairs; i++) {
-        seed = 0x41C64E6D * seed + 0x00006073;
+        seed = LCG_MUL * seed + LCG_ADD;
         uint16_t xorVal = static_cast<uint16_t>(seed >> 16);
         uint16_t val = readU16LE(data + i * 2);
         val ^= xorVal;
@@ -33,208 +136,189 @@ void PokeCrypto::cryptArray(uint8_t* data, size_t len, uint32_t seed) {
     }
 }
 
-static void shuffleArray(const uint8_t* data, size_t len, uint32_t sv, int blockSize, uint8_t* out) {
-    constexpr int start = 8;
-    int blockCount = PokeCrypto::BLOCK_COUNT;
-    int index = static_cast<int>(sv) * blockCount;
-    int end = start + blockSize * blockCount;
-
-    // Copy header (first 8 bytes)
-    std::memcpy(out, data, start);
-    // Copy tail (after all blocks)
-    if (static_cast<int>(len) > end)
-        std::memcpy(out + end, data + end, len - end);
-    // Shuffle blocks
-    for (int block = 0; block < blockCount; block++) {
-        int destOfs = start + blockSize * block;
-        int srcBlock = BLOCK_POSITION[index + block];
-        int srcOfs = start + blockSize * srcBlock;
-        std::memcpy(out + destOfs, data + srcOfs, blockSize);
-    }
-}
+// --- Gen6+ entities: LCG cipher over 4 shuffled blocks + party stats ---
 
-void PokeCrypto::decryptArray9(const uint8_t* ekm, size_t len, uint8_t* outBuf) {
-    // Make a working copy to decrypt in-place
-    uint8_t tmp[SIZE_9PARTY];
-    size_t sz = len > SIZE_9PARTY ? SIZE_9PARTY : len;
-    std::memcpy(tmp, ekm, sz);
+// Seeds at the start of each of the 4 blocks, as jumps from the PV
+struct BlockJumps {
+    LcgJump at[PokeCrypto::BLOCK_COUNT];
+};
 
-    uint32_t pv = readU32LE(tmp);
-    uint32_t sv = (pv >> 13) & 31;
+static constexpr BlockJumps blockJumps(int blockSize) {
+    BlockJumps j{};
+    for (int b = 0; b < PokeCrypto::BLOCK_COUNT; b++)
+        j.at[b] = lcgJump(b * blockSize / 2);
+    return j;
+}
+
+static constexpr BlockJumps JUMPS_9  = blockJumps(PokeCrypto::BLOCK_SIZE);
+static constexpr BlockJumps JUMPS_8A = blockJumps(PokeCrypto::SIZE_8ABLOCK);
+static constexpr BlockJumps JUMPS_6  = blockJumps(PokeCrypto::SIZE_6BLOCK);
 
-    // Decrypt blocks (offset 8 to 8 + 4*80 = 328)
+// Decrypt or encrypt one entity from in to out in a single pass: each block
+// is XORed straight into its shuffled position, with its keystream started
+// at that block's offset in the encrypted layout (the input when decrypting,
+// the output when encrypting). in and out must not overlap.
+static void cryptShuffle(const uint8_t* in, size_t len, uint8_t* out, size_t partySize,
+                         int blockSize, const BlockJumps& jumps, bool decrypt) {
     constexpr int start = 8;
-    int end = BLOCK_COUNT * BLOCK_SIZE + start;
-    cryptArray(tmp + start, end - start, pv);
+    int end = PokeCrypto::BLOCK_COUNT * blockSize + start;
+    size_t sz = len > partySize ? partySize : len;
+
+    // Short input: pad a copy so the blocks are always complete
+    uint8_t padded[PokeCrypto::MAX_PARTY_SIZE];
+    if (static_cast<int>(sz) < end) {
+        std::memcpy(padded, in, sz);
+        std::memset(padded + sz, 0, partySize - sz);
+        in = padded;
+    }
 
-    // Decrypt party stats (if present)
+    uint32_t pv = readU32LE(in);
+    uint32_t sv = (pv >> 13) & 31;
+    const uint8_t* order = &BLOCK_POSITION[(decrypt ? sv : BLOCK_POSITION_INVERT[sv]) * PokeCrypto::BLOCK_COUNT];
+
+    std::memcpy(out, in, start);
+    for (int block = 0; block < PokeCrypto::BLOCK_COUNT; block++) {
+        int from = order[block];
+        const LcgJump& j = jumps.at[decrypt ? from : block];
+        cryptArrayTo(in + start + blockSize * from, out + start + blockSize * block,
+                     blockSize, j.mul * pv + j.add);
+    }
+
+    // Party stats (if present) restart the keystream from the PV
     if (static_cast<int>(sz) > end)
-        cryptArray(tmp + end, sz - end, pv);
+        cryptArrayTo(in + end, out + end, sz - end, pv);
+}
 
-    // Unshuffle blocks
-    shuffleArray(tmp, sz, sv, BLOCK_SIZE, outBuf);
+void PokeCrypto::decryptArray9(const uint8_t* ekm, size_t len, uint8_t* outBuf) {
+    cryptShuffle(ekm, len, outBuf, SIZE_9PARTY, BLOCK_SIZE, JUMPS_9, true);
 }
 
 void PokeCrypto::encryptArray9(const uint8_t* pk, size_t len, uint8_t* outBuf) {
-    uint32_t pv = readU32LE(pk);
-    uint32_t sv = (pv >> 13) & 31;
-
-    // Inverse shuffle
-    shuffleArray(pk, len, BLOCK_POSITION_INVERT[sv], BLOCK_SIZE, outBuf);
-
-    // Encrypt blocks
-    constexpr int start = 8;
-    int end = BLOCK_COUNT * BLOCK_SIZE + start;
-    cryptArray(outBuf + start, end - start, pv);
-
-    // Encrypt party stats
-    if (static_cast<int>(len) > end)
-        cryptArray(outBuf + end, len - end, pv);
+    cryptShuffle(pk, len, outBuf, SIZE_9PARTY, BLOCK_SIZE, JUMPS_9, false);
 }
 
 // --- PA8 (Legends: Arceus) — same algorithm, larger block size (0x58) ---
 
 void PokeCrypto::decryptArray8A(const uint8_t* ekm, size_t len, uint8_t* outBuf) {
-    uint8_t tmp[SIZE_8APARTY];
-    size_t sz = len > SIZE_8APARTY ? SIZE_8APARTY : len;
-    std::memcpy(tmp, ekm, sz);
-    if (sz < SIZE_8APARTY)
-        std::memset(tmp + sz, 0, SIZE_8APARTY - sz);
-
-    uint32_t pv = readU32LE(tmp);
-    uint32_t sv = (pv >> 13) & 31;
-
-    // Decrypt blocks (offset 8 to 8 + 4*88 = 360)
-    constexpr int start = 8;
-    int end = BLOCK_COUNT * SIZE_8ABLOCK + start;
-    cryptArray(tmp + start, end - start, pv);
-
-    // Decrypt party stats (if present)
-    if (static_cast<int>(sz) > end)
-        cryptArray(tmp + end, sz - end, pv);
-
-    // Unshuffle blocks
-    shuffleArray(tmp, sz, sv, SIZE_8ABLOCK, outBuf);
+    cryptShuffle(ekm, len, outBuf, SIZE_8APARTY, SIZE_8ABLOCK, JUMPS_8A, true);
 }
 
 void PokeCrypto::encryptArray8A(const uint8_t* pk, size_t len, uint8_t* outBuf) {
-    uint32_t pv = readU32LE(pk);
-    uint32_t sv = (pv >> 13) & 31;
-
-    // Inverse shuffle
-    shuffleArray(pk, len, BLOCK_POSITION_INVERT[sv], SIZE_8ABLOCK, outBuf);
-
-    // Encrypt blocks
-    constexpr int start = 8;
-    int end = BLOCK_COUNT * SIZE_8ABLOCK + start;
-    cryptArray(outBuf + start, end - start, pv);
-
-    // Encrypt party stats
-    if (static_cast<int>(len) > end)
-        cryptArray(outBuf + end, len - end, pv);
+    cryptShuffle(pk, len, outBuf, SIZE_8APARTY, SIZE_8ABLOCK, JUMPS_8A, false);
 }
 
 // --- PB7 (Let's Go Pikachu/Eevee) — same algorithm, smaller block size (56) ---
 
 void PokeCrypto::decryptArray6(const uint8_t* ekm, size_t len, uint8_t* outBuf) {
-    uint8_t tmp[SIZE_6PARTY];
-    size_t sz = len > SIZE_6PARTY ? SIZE_6PARTY : len;
-    std::memcpy(tmp, ekm, sz);
-    if (sz < SIZE_6PARTY)
-        std::memset(tmp + sz, 0, SIZE_6PARTY - sz);
-
-    uint32_t pv = readU32LE(tmp);
-    uint32_t sv = (pv >> 13) & 31;
-
-    // Decrypt blocks (offset 8 to 8 + 4*56 = 232)
-    constexpr int start = 8;
-    int end = BLOCK_COUNT * SIZE_6BLOCK + start;
-    cryptArray(tmp + start, end - start, pv);
-
-    // Decrypt party stats (if present)
-    if (static_cast<int>(sz) > end)
-        cryptArray(tmp + end, sz - end, pv);
-
-    // Unshuffle blocks
-    shuffleArray(tmp, sz, sv, SIZE_6BLOCK, outBuf);
+    cryptShuffle(ekm, len, outBuf, SIZE_6PARTY, SIZE_6BLOCK, JUMPS_6, true);
 }
 
 void PokeCrypto::encryptArray6(const uint8_t* pk, size_t len, uint8_t* outBuf) {
-    uint32_t pv = readU32LE(pk);
-    uint32_t sv = (pv >> 13) & 31;
-
-    // Inverse shuffle
-    shuffleArray(pk, len, BLOCK_POSITION_INVERT[sv], SIZE_6BLOCK, outBuf);
-
-    // Encrypt blocks
-    constexpr int start = 8;
-    int end = BLOCK_COUNT * SIZE_6BLOCK + start;
-    cryptArray(outBuf + start, end - start, pv);
-
-    // Encrypt party stats
-    if (static_cast<int>(len) > end)
-        cryptArray(outBuf + end, len - end, pv);
+    cryptShuffle(pk, len, outBuf, SIZE_6PARTY, SIZE_6BLOCK, JUMPS_6, false);
 }
 
 // --- PK3 (FireRed/LeafGreen) — constant XOR (not LCG), 12-byte blocks ---
 
-// Gen3 XOR: each u32 in data[0x20..0x50] is XORed with the SAME seed (no LCG advancement)
-static void cryptArray3(uint8_t* data, uint32_t seed) {
-    for (int i = PokeCrypto::SIZE_3HEADER; i < PokeCrypto::SIZE_3STORED; i += 4) {
-        uint32_t val = readU32LE(data + i);
-        val ^= seed;
-        std::memcpy(data + i, &val, 4);
-    }
-}
-
-// Gen3 shuffle: uses same BLOCK_POSITION table but with 12-byte blocks starting at offset 32
-static void shuffleArray3(const uint8_t* data, size_t len, uint32_t sv, uint8_t* out) {
+// Gen3: each u32 of the 4 blocks is XORed with the SAME seed (PID ^ OID, no
+// LCG advancement), and blocks are shuffled by PID % 24. Done in one pass
+// like cryptShuffle(); the seed does not depend on position.
+static void cryptShuffle3(const uint8_t* in, size_t len, uint8_t* out, bool decrypt) {
     constexpr int hdr = PokeCrypto::SIZE_3HEADER;
     constexpr int blkSz = PokeCrypto::SIZE_3BLOCK;
     constexpr int blkCount = PokeCrypto::BLOCK_COUNT;
-    int index = static_cast<int>(sv) * blkCount;
-
-    // Copy header (first 32 bytes)
-    std::memcpy(out, data, hdr);
-    // Copy party stats tail (if present, bytes 80+)
-    if (static_cast<int>(len) > PokeCrypto::SIZE_3STORED)
-        std::memcpy(out + PokeCrypto::SIZE_3STORED, data + PokeCrypto::SIZE_3STORED,
-                     len - PokeCrypto::SIZE_3STORED);
-    // Shuffle 4 blocks of 12 bytes
+    size_t sz = len > PokeCrypto::SIZE_3PARTY ? PokeCrypto::SIZE_3PARTY : len;
+
+    uint8_t padded[PokeCrypto::SIZE_3PARTY];
+    if (sz < static_cast<size_t>(PokeCrypto::SIZE_3STORED)) {
+        std::memcpy(padded, in, sz);
+        std::memset(padded + sz, 0, PokeCrypto::SIZE_3PARTY - sz);
+        in = padded;
+    }
+
+    uint32_t pid = readU32LE(in);
+    uint32_t seed = pid ^ readU32LE(in + 4);
+    uint32_t sv = pid % 24;
+    const uint8_t* order = &BLOCK_POSITION[(decrypt ? sv : BLOCK_POSITION_INVERT[sv]) * blkCount];
+
+    // Copy header (first 32 bytes) and party stats tail (if present, bytes 80+)
+    std::memcpy(out, in, hdr);
+    if (sz > static_cast<size_t>(PokeCrypto::SIZE_3STORED))
+        std::memcpy(out + PokeCrypto::SIZE_3STORED, in + PokeCrypto::SIZE_3STORED,
+                    sz - PokeCrypto::SIZE_3STORED);
+
     for (int block = 0; block < blkCount; block++) {
-        int destOfs = hdr + blkSz * block;
-        int srcBlock = BLOCK_POSITION[index + block];
-        int srcOfs = hdr + blkSz * srcBlock;
-        std::memcpy(out + destOfs, data + srcOfs, blkSz);
+        const uint8_t* src = in + hdr + blkSz * order[block];
+        uint8_t* dst = out + hdr + blkSz * block;
+        for (int i = 0; i < blkSz; i += 4) {
+            uint32_t val = readU32LE(src + i) ^ seed;
+            std::memcpy(dst + i, &val, 4);
+        }
     }
 }
 
 void PokeCrypto::decryptArray3(const uint8_t* ekm, size_t len, uint8_t* outBuf) {
-    uint8_t tmp[SIZE_3PARTY];
-    size_t sz = len > SIZE_3PARTY ? SIZE_3PARTY : len;
-    std::memcpy(tmp, ekm, sz);
-    if (sz < SIZE_3PARTY)
-        std::memset(tmp + sz, 0, SIZE_3PARTY - sz);
+    cryptShuffle3(ekm, len, outBuf, true);
+}
+
+void PokeCrypto::encryptArray3(const uint8_t* pk, size_t len, uint8_t* outBuf) {
+    cryptShuffle3(pk, len, outBuf, false);
+}
 
-    uint32_t pid = readU32LE(tmp);
-    uint32_t oid = readU32LE(tmp + 4);
-    uint32_t seed = pid ^ oid;
+// --- Whole boxes ---
 
-    // Decrypt blocks (constant XOR, not LCG)
-    cryptArray3(tmp, seed);
+// Hint the next slot into cache while the current one is processed
+static inline void prefetchSlot(const uint8_t* p, size_t len, int rw) {
+#if defined(__GNUC__)
+    for (size_t i = 0; i < len; i += 64) {
+        if (rw) __builtin_prefetch(p + i, 1);
+        else    __builtin_prefetch(p + i, 0);
+    }
+#else
+    (void)p; (void)len; (void)rw;
+#endif
+}
 
-    // Unshuffle blocks using PID % 24
-    shuffleArray3(tmp, sz, pid % 24, outBuf);
+static void decryptOne(PokeCrypto::Format fmt, const uint8_t* ekm, size_t len, uint8_t* out) {
+    switch (fmt) {
+        case PokeCrypto::Format::Gen9:  PokeCrypto::decryptArray9(ekm, len, out);  break;
+        case PokeCrypto::Format::Gen8A: PokeCrypto::decryptArray8A(ekm, len, out); break;
+        case PokeCrypto::Format::Gen6:  PokeCrypto::decryptArray6(ekm, len, out);  break;
+        case PokeCrypto::Format::Gen3:  PokeCrypto::decryptArray3(ekm, len, out);  break;
+    }
 }
 
-void PokeCrypto::encryptArray3(const uint8_t* pk, size_t len, uint8_t* outBuf) {
-    uint32_t pid = readU32LE(pk);
+static void encryptOne(PokeCrypto::Format fmt, const uint8_t* pk, size_t len, uint8_t* out) {
+    switch (fmt) {
+        case PokeCrypto::Format::Gen9:  PokeCrypto::encryptArray9(pk, len, out);  break;
+        case PokeCrypto::Format::Gen8A: PokeCrypto::encryptArray8A(pk, len, out); break;
+        case PokeCrypto::Format::Gen6:  PokeCrypto::encryptArray6(pk, len, out);  break;
+        case PokeCrypto::Format::Gen3:  PokeCrypto::encryptArray3(pk, len, out);  break;
+    }
+}
 
-    // Inverse shuffle
-    shuffleArray3(pk, len, BLOCK_POSITION_INVERT[pid % 24], outBuf);
+void PokeCrypto::decryptBox(Format fmt, const uint8_t* box, int count, size_t stride, size_t gap,
+                            uint8_t* const* outs) {
+    size_t len = stride - gap;
+    for (int i = 0; i < count; i++) {
+        if (i + 1 < count) {
+            prefetchSlot(box + (i + 1) * stride, len, 0);
+            prefetchSlot(outs[i + 1], len, 1);
+        }
+        decryptOne(fmt, box + i * stride, len, outs[i]);
+    }
+}
 
-    // Encrypt blocks (constant XOR)
-    uint32_t oid = readU32LE(pk + 4);
-    uint32_t seed = pid ^ oid;
-    cryptArray3(outBuf, seed);
+void PokeCrypto::encryptBox(Format fmt, const uint8_t* const* ins, int count,
+                            uint8_t* box, size_t stride, size_t gap) {
+    size_t len = stride - gap;
+    for (int i = 0; i < count; i++) {
+        if (i + 1 < count) {
+            prefetchSlot(ins[i + 1], len, 0);
+            prefetchSlot(box + (i + 1) * stride, stride, 1);
+        }
+        uint8_t* slot = box + i * stride;
+        encryptOne(fmt, ins[i], len, slot);
+        if (gap > 0)
+            std::memset(slot + len, 0, gap);
+    }
 }
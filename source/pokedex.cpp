@@ -13,6 +13,8 @@
 #include "personal_bdsp.h"
 #include <cstring>
 #include <algorithm>
+#include <vector>
+#include <utility>
 
 namespace Pokedex {
 
@@ -20,6 +22,36 @@ namespace Pokedex {
 //  Common helpers
 // ============================================================
 
+namespace {
+
+// Save data the register functions write into. Lookups are made on first
+// use and reused for the rest of a batch (see the batch registerPokemon()).
+struct DexTargets {
+    SaveFile& save;
+    std::vector<std::pair<uint32_t, SCBlock*>> blocks;
+    std::vector<std::pair<int, uint8_t*>> sectors;
+
+    explicit DexTargets(SaveFile& s) : save(s) {}
+
+    SCBlock* block(uint32_t key) {
+        for (auto& [k, b] : blocks)
+            if (k == key) return b;
+        SCBlock* b = save.findBlock(key);
+        blocks.emplace_back(key, b);
+        return b;
+    }
+
+    uint8_t* gbaSector(int sectionId) {
+        for (auto& [id, d] : sectors)
+            if (id == sectionId) return d;
+        uint8_t* d = save.findGbaSectorData(sectionId);
+        sectors.emplace_back(sectionId, d);
+        return d;
+    }
+};
+
+} // anon
+
 // Language ID → dex bit index.  Skips lang 0 and lang 6.
 // Maps: 1→0, 2→1, 3→2, 4→3, 5→4, 7→5, 8→6, 9→7, 10→8
 static int getDexLangFlag(int lang) {
@@ -153,8 +185,8 @@ static uint8_t calcDisplayGenderZA(uint8_t gender, uint16_t species, uint8_t for
 
 } // anon
 
-static void registerZA(SaveFile& save, const Pokemon& pkm) {
-    SCBlock* block = save.findBlock(0x2D87BE5C);
+static void registerZA(DexTargets& dex, const Pokemon& pkm) {
+    SCBlock* block = dex.block(0x2D87BE5C);
     if (!block || block->data.empty()) return;
 
     uint16_t species = pkm.species();
@@ -294,8 +326,8 @@ static void updateAdjacent(SCBlock* block, uint16_t species) {
 
 } // anon
 
-static void registerSVKitakami(SaveFile& save, const Pokemon& pkm) {
-    SCBlock* block = save.findBlock(0xF5D7C0E2);
+static void registerSVKitakami(DexTargets& dex, const Pokemon& pkm) {
+    SCBlock* block = dex.block(0xF5D7C0E2);
     if (!block || block->data.empty()) return;
 
     uint16_t species = pkm.species();
@@ -329,7 +361,7 @@ static void registerSVKitakami(SaveFile& save, const Pokemon& pkm) {
 
     // Set language — both Pokemon language and save file language (PKHeX parity)
     writeU16LE(e + SVK_LANGUAGE, readU16LE(e + SVK_LANGUAGE) | langBitMask(pkm.language()));
-    uint8_t saveLang = save.saveLanguage();
+    uint8_t saveLang = dex.save.saveLanguage();
     if (saveLang != 0 && saveLang != pkm.language())
         writeU16LE(e + SVK_LANGUAGE, readU16LE(e + SVK_LANGUAGE) | langBitMask(saveLang));
 
@@ -616,7 +648,7 @@ static SwShDexResult getSwShDex(uint16_t species) {
 
 } // anon
 
-static void registerSwSh(SaveFile& save, const Pokemon& pkm) {
+static void registerSwSh(DexTargets& dex, const Pokemon& pkm) {
     uint16_t species = pkm.species();
     uint8_t  form    = pkm.form();
     uint8_t  gender  = pkm.gender();
@@ -625,7 +657,7 @@ static void registerSwSh(SaveFile& save, const Pokemon& pkm) {
     auto [dexIdx, blockKey] = getSwShDex(species);
     if (dexIdx == 0) return;
 
-    SCBlock* block = save.findBlock(blockKey);
+    SCBlock* block = dex.block(blockKey);
     if (!block || block->data.empty()) return;
 
     size_t entryOfs = static_cast<size_t>(dexIdx - 1) * SWSH_ENTRY_SIZE;
@@ -740,9 +772,9 @@ constexpr size_t BDSP_LANG_BASE       = 0x28FC;
 
 } // anon
 
-static void registerBDSP(SaveFile& save, const Pokemon& pkm) {
-    uint8_t* raw = save.rawData();
-    size_t rawSize = save.rawDataSize();
+static void registerBDSP(DexTargets& dex, const Pokemon& pkm) {
+    uint8_t* raw = dex.save.rawData();
+    size_t rawSize = dex.save.rawDataSize();
 
     if (rawSize < BDSP_ZUKAN_OFFSET + BDSP_ZUKAN_SIZE) return;
 
@@ -859,9 +891,9 @@ constexpr uint32_t LGPE_MAX_CAPTURE_TOTAL  = 999999999;
 
 } // anon
 
-static void registerLGPE(SaveFile& save, const Pokemon& pkm) {
-    uint8_t* raw = save.rawData();
-    size_t rawSize = save.rawDataSize();
+static void registerLGPE(DexTargets& dex, const Pokemon& pkm) {
+    uint8_t* raw = dex.save.rawData();
+    size_t rawSize = dex.save.rawDataSize();
 
     size_t dexBase = LGPE_ZUKAN_BLOCK_OFFSET;
     // Ensure enough room for the size data at the end of the block
@@ -989,12 +1021,12 @@ static void setFlagBit(uint8_t* base, int species) {
     base[bit >> 3] |= static_cast<uint8_t>(1 << (bit & 7));
 }
 
-static void registerFRLG(SaveFile& save, const Pokemon& pkm) {
+static void registerFRLG(DexTargets& dex, const Pokemon& pkm) {
     uint16_t species = pkm.species();
     if (species == 0 || species > FRLG_MAX_SPECIES) return;
 
     // Section 0: caught + seen (primary)
-    uint8_t* sect0 = save.findGbaSectorData(0);
+    uint8_t* sect0 = dex.gbaSector(0);
     if (!sect0) return;
 
     uint8_t* pdx = sect0 + FRLG_POKEDEX_OFS;
@@ -1016,12 +1048,12 @@ static void registerFRLG(SaveFile& save, const Pokemon& pkm) {
     setFlagBit(pdx + FRLG_SEEN_OFS, species);
 
     // Sync seen copy in section 1
-    uint8_t* sect1 = save.findGbaSectorData(FRLG_SEEN2_SECTION);
+    uint8_t* sect1 = dex.gbaSector(FRLG_SEEN2_SECTION);
     if (sect1)
         setFlagBit(sect1 + FRLG_SEEN2_OFFSET, species);
 
     // Sync seen copy in section 4
-    uint8_t* sect4 = save.findGbaSectorData(FRLG_SEEN3_SECTION);
+    uint8_t* sect4 = dex.gbaSector(FRLG_SEEN3_SECTION);
     if (sect4)
         setFlagBit(sect4 + FRLG_SEEN3_OFFSET, species);
 }
@@ -1030,24 +1062,33 @@ static void registerFRLG(SaveFile& save, const Pokemon& pkm) {
 //  Dispatcher
 // ============================================================
 
-void registerPokemon(SaveFile& save, const Pokemon& pkm) {
+static void registerOne(DexTargets& dex, GameType game, const Pokemon& pkm) {
     if (pkm.isEmpty() || pkm.isEgg()) return;
 
-    GameType game = save.gameType();
-
     // Only register for dual/paired games (version exclusives require cross-save transfer).
     // ZA and LA are single games — all Pokemon obtainable in one playthrough.
     if (isSV(game)) {
-        registerSVKitakami(save, pkm);
+        registerSVKitakami(dex, pkm);
     } else if (isSwSh(game)) {
-        registerSwSh(save, pkm);
+        registerSwSh(dex, pkm);
     } else if (isBDSP(game)) {
-        registerBDSP(save, pkm);
+        registerBDSP(dex, pkm);
     } else if (isLGPE(game)) {
-        registerLGPE(save, pkm);
+        registerLGPE(dex, pkm);
     } else if (isFRLG(game)) {
-        registerFRLG(save, pkm);
+        registerFRLG(dex, pkm);
     }
 }
 
+void registerPokemon(SaveFile& save, const Pokemon& pkm) {
+    registerPokemon(save, &pkm, 1);
+}
+
+void registerPokemon(SaveFile& save, const Pokemon* pkms, size_t count) {
+    DexTargets dex(save);
+    GameType game = save.gameType();
+    for (size_t i = 0; i < count; i++)
+        registerOne(dex, game, pkms[i]);
+}
+
 } // namespace Pokedex
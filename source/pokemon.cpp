@@ -1,5 +1,8 @@
 #include "pokemon.h"
 #include "species_converter.h"
+#include "form_names.h"
+#include <algorithm>
+#include <cstdio>
 
 // Experience growth tables (from PKHeX.Core Experience.cs)
 // 6 tables x 100 entries: minimum EXP for each level (1-100)
@@ -448,6 +451,50 @@ std::string Pokemon::displayName() const {
     return SpeciesName::get(species());
 }
 
+std::string Pokemon::exportFileName(GameType game) const {
+    char buf[512];
+    uint16_t sp = species();
+    uint8_t fm = form();
+
+    std::string formStr;
+    if (fm != 0) {
+        const char* formName = getFormName(sp, fm);
+        if (formName)
+            formStr = std::string(" - ") + formName;
+        else {
+            char fb[16];
+            std::snprintf(fb, sizeof(fb), " - %02u", fm);
+            formStr = fb;
+        }
+    }
+
+    std::string tags;
+    {
+        std::string flags;
+        if (isShiny()) flags += "S";
+        if (isAlpha()) flags += "A";
+        if (isEgg())   flags += "E";
+        if (!flags.empty()) tags = " - [" + flags + "]";
+    }
+    const std::string& nick = SpeciesName::get(sp);
+
+    // Checksum at 0x06 for modern, 0x1C for PK3
+    uint16_t chk = isFRLG(game) ? readU16(0x1C) : readU16(0x06);
+
+    std::snprintf(buf, sizeof(buf), "%s - %04u%s%s - %s - %04X%08X.%s",
+                  gameInfo(game).gameTag, sp, formStr.c_str(), tags.c_str(), nick.c_str(),
+                  chk, encryptionConstant(), pkFileExtension(game));
+
+    // Sanitize filename: replace filesystem-unsafe chars
+    std::string filename = buf;
+    for (char& c : filename) {
+        if (c == '/' || c == '\\' || c == ':' || c == '*' ||
+            c == '?' || c == '"' || c == '<' || c == '>' || c == '|')
+            c = '_';
+    }
+    return filename;
+}
+
 // --- Ribbon & Mark reader ---
 
 // {display name, romfs filename (no path/ext), isMark}
@@ -676,6 +723,46 @@ void Pokemon::loadFromEncrypted(const uint8_t* encrypted, size_t len) {
         PokeCrypto::decryptArray9(encrypted, len, data.data());
 }
 
+static PokeCrypto::Format cryptFormat(GameType g) {
+    if (isFRLG(g)) return PokeCrypto::Format::Gen3;
+    if (isLGPE(g)) return PokeCrypto::Format::Gen6;
+    if (g == GameType::LA) return PokeCrypto::Format::Gen8A;
+    return PokeCrypto::Format::Gen9;
+}
+
+// decryptBox()/encryptBox() hand PokeCrypto one data pointer per slot, a
+// chunk at a time; each Pokemon is its own object, so no stride is assumed
+static constexpr int BOX_CRYPT_CHUNK = 32;
+
+void Pokemon::decryptBox(GameType game, const uint8_t* box, int count,
+                         size_t stride, size_t gap, Pokemon* out) {
+    PokeCrypto::Format fmt = cryptFormat(game);
+    uint8_t* outs[BOX_CRYPT_CHUNK];
+    for (int first = 0; first < count; first += BOX_CRYPT_CHUNK) {
+        int n = std::min(BOX_CRYPT_CHUNK, count - first);
+        for (int i = 0; i < n; i++) {
+            out[first + i].gameType_ = game;
+            outs[i] = out[first + i].data.data();
+        }
+        PokeCrypto::decryptBox(fmt, box + first * stride, n, stride, gap, outs);
+    }
+}
+
+void Pokemon::encryptBox(GameType game, Pokemon* pkms, int count,
+                         uint8_t* box, size_t stride, size_t gap) {
+    PokeCrypto::Format fmt = cryptFormat(game);
+    const uint8_t* ins[BOX_CRYPT_CHUNK];
+    for (int first = 0; first < count; first += BOX_CRYPT_CHUNK) {
+        int n = std::min(BOX_CRYPT_CHUNK, count - first);
+        for (int i = 0; i < n; i++) {
+            pkms[first + i].gameType_ = game;
+            pkms[first + i].refreshChecksum();
+            ins[i] = pkms[first + i].data.data();
+        }
+        PokeCrypto::encryptBox(fmt, ins, n, box + first * stride, stride, gap);
+    }
+}
+
 void Pokemon::refreshChecksum() {
     if (isFRLG(gameType_)) {
         // PK3: sum u16 words from 0x20 to 0x4F (48 bytes = 24 words), store at 0x1C
@@ -0,0 +1,142 @@
+#include "profiler.h"
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t ZONE_COUNT   = size_t(ProfZone::Count);
+constexpr size_t RING_CAPACITY = 1 << 16;   // ~1 MB of events, allocated on enable
+
+struct TraceEvent {
+    uint64_t startUs;   // since the profiler epoch
+    uint32_t durUs;
+    uint8_t  zone;
+    uint8_t  tid;
+};
+
+struct State {
+    std::mutex mutex;
+    Clock::time_point epoch = Clock::now();
+    Clock::time_point frameStart = epoch;
+    Profiler::FrameStats current;
+    Profiler::FrameStats last;
+    std::vector<TraceEvent> ring;
+    size_t ringNext = 0;
+    bool   ringWrapped = false;
+};
+
+State& state() {
+    static State s;
+    return s;
+}
+
+// Small stable per-thread ids for the trace's "tid" field
+uint8_t threadId() {
+    static std::atomic<int> next{0};
+    thread_local uint8_t id = static_cast<uint8_t>(next.fetch_add(1, std::memory_order_relaxed));
+    return id;
+}
+
+const char* const ZONE_NAMES[ZONE_COUNT] = {
+    "present", "draw", "slotDisplays", "spriteLoad", "text", "boxDecrypt",
+    "saveLoad", "saveWrite", "bankLoad", "bankSave", "swishCrypt", "swishHash",
+};
+
+} // namespace
+
+std::atomic<bool> Profiler::enabled_{false};
+
+void Profiler::setEnabled(bool on) {
+    State& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (on && s.ring.empty())
+            s.ring.resize(RING_CAPACITY);
+        s.current = FrameStats{};
+        s.frameStart = Clock::now();
+    }
+    enabled_.store(on, std::memory_order_relaxed);
+}
+
+void Profiler::record(ProfZone zone, Clock::time_point start, Clock::time_point end) {
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    State& s = state();
+    uint8_t tid = threadId();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.ring.empty())
+        return; // enabled_ raced with setEnabled(true)
+
+    size_t z = size_t(zone);
+    s.current.zoneMs[z] += duration<double, std::milli>(end - start).count();
+    s.current.calls[z]++;
+
+    TraceEvent& ev = s.ring[s.ringNext];
+    ev.startUs = duration_cast<microseconds>(start - s.epoch).count();
+    ev.durUs   = static_cast<uint32_t>(duration_cast<microseconds>(end - start).count());
+    ev.zone    = static_cast<uint8_t>(zone);
+    ev.tid     = tid;
+    if (++s.ringNext == s.ring.size()) {
+        s.ringNext = 0;
+        s.ringWrapped = true;
+    }
+}
+
+void Profiler::frameMark() {
+    if (!enabled())
+        return;
+    State& s = state();
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.current.frameMs = std::chrono::duration<double, std::milli>(now - s.frameStart).count();
+    s.last = s.current;
+    s.current = FrameStats{};
+    s.frameStart = now;
+}
+
+Profiler::FrameStats Profiler::lastFrame() {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.last;
+}
+
+const char* Profiler::zoneName(ProfZone zone) {
+    size_t z = size_t(zone);
+    return z < ZONE_COUNT ? ZONE_NAMES[z] : "?";
+}
+
+size_t Profiler::eventCount() {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.ringWrapped ? s.ring.size() : s.ringNext;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    State& s = state();
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.ringWrapped)
+            events.assign(s.ring.begin() + s.ringNext, s.ring.end());
+        events.insert(events.end(), s.ring.begin(), s.ring.begin() + s.ringNext);
+    }
+
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent& ev = events[i];
+        std::fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                        "\"ts\":%llu,\"dur\":%u}",
+                     i ? ",\n" : "", ZONE_NAMES[ev.zone], unsigned(ev.tid),
+                     static_cast<unsigned long long>(ev.startUs), unsigned(ev.durUs));
+    }
+    std::fputs("\n]}\n", f);
+    return std::fclose(f) == 0;
+}
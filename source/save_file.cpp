@@ -3,13 +3,19 @@
 #include "pokedex.h"
 #include "binary_io.h"
 #include "md5.h"
+#include "profiler.h"
+#include "task_pool.h"
 #include <fstream>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
 void SaveFile::setGameType(GameType game) {
     gameType_ = game;
     invalidateAllBoxCache();
+    prefetchQueue_.clear();
+    trainerInfoCached_ = false;
+    searchIndex_.reset(0);
     auto& info   = gameInfo(game);
     gapBoxSlot_  = info.saveGapSize;
     sizeBoxSlot_ = info.saveSlotSize;
@@ -26,11 +32,16 @@ bool SaveFile::isBDSPSize(size_t size) {
 }
 
 bool SaveFile::load(const std::string& path) {
+    Profiler::Scope probe(ProfZone::SaveLoad);
     filePath_ = path;
     loaded_ = false;
     boxData_ = nullptr;
     boxLayoutData_ = nullptr;
+    boxBlockIdx_ = SIZE_MAX;
     invalidateAllBoxCache();
+    prefetchQueue_.clear();
+    trainerInfoCached_ = false;
+    searchIndex_.reset(0);
 
     if (isFRLG(gameType_))
         return loadGBA(path);
@@ -44,6 +55,7 @@ bool SaveFile::load(const std::string& path) {
 bool SaveFile::save(const std::string& path) {
     if (!loaded_)
         return false;
+    Profiler::Scope probe(ProfZone::SaveWrite);
 
     if (isFRLG(gameType_))
         return saveGBA(path);
@@ -62,25 +74,36 @@ bool SaveFile::loadSCBlock(const std::string& path) {
     auto fileSize = file.tellg();
     file.seekg(0);
 
-    std::vector<uint8_t> fileData(fileSize);
-    file.read(reinterpret_cast<char*>(fileData.data()), fileSize);
+    // Drop blocks that still view the previous arena before replacing it
+    blocks_.clear();
+    blockIndex_.clear();
+    encryptedImage_.assign(static_cast<size_t>(fileSize), 0);
+    file.read(reinterpret_cast<char*>(encryptedImage_.data()), fileSize);
     file.close();
-
-    // Save original file data for round-trip verification (decrypt modifies in-place)
-    originalFileData_ = fileData;
-
-    // Decrypt into SCBlocks
-    blocks_ = SwishCrypto::decrypt(fileData.data(), fileData.size());
+    imagePath_ = path;
+
+    // Decrypt a copy in-place into SCBlocks viewing the arena; the encrypted
+    // image is kept for incremental saves and round-trip verification
+    blockArena_ = encryptedImage_;
+    if (!SwishCrypto::decrypt(blockArena_.data(), blockArena_.size(), blocks_)) {
+        blockArena_.clear();
+        encryptedImage_.clear();
+        imagePath_.clear();
+        return false;
+    }
+    rebuildBlockIndex();
+    rebuildBlockOffsets();
 
     // Find box data block
-    SCBlock* boxBlock = SwishCrypto::findBlock(blocks_, kbox_);
+    SCBlock* boxBlock = lookupBlock(kbox_);
     if (!boxBlock)
         return false;
+    boxBlockIdx_ = static_cast<size_t>(boxBlock - blocks_.data());
     boxData_ = boxBlock->data.data();
     boxDataLen_ = boxBlock->data.size();
 
     // Find box layout block (box names)
-    SCBlock* layoutBlock = SwishCrypto::findBlock(blocks_, KBOX_LAYOUT);
+    SCBlock* layoutBlock = lookupBlock(KBOX_LAYOUT);
     if (layoutBlock) {
         boxLayoutData_ = layoutBlock->data.data();
         boxLayoutLen_ = layoutBlock->data.size();
@@ -90,23 +113,109 @@ bool SaveFile::loadSCBlock(const std::string& path) {
     return true;
 }
 
+void SaveFile::rebuildBlockIndex() {
+    blockIndex_.clear();
+    blockIndex_.reserve(blocks_.size());
+    // First occurrence wins, matching the old linear SwishCrypto::findBlock
+    for (size_t i = 0; i < blocks_.size(); i++)
+        blockIndex_.emplace(blocks_[i].key, i);
+}
+
+void SaveFile::rebuildBlockOffsets() {
+    blockOffsets_.resize(blocks_.size() + 1);
+    size_t pos = 0;
+    for (size_t i = 0; i < blocks_.size(); i++) {
+        blockOffsets_[i] = pos;
+        pos += blocks_[i].encodedSize();
+    }
+    blockOffsets_[blocks_.size()] = pos;
+    blockDirty_.assign(blocks_.size(), 0);
+}
+
+SCBlock* SaveFile::lookupBlock(uint32_t key) {
+    auto it = blockIndex_.find(key);
+    return it != blockIndex_.end() ? &blocks_[it->second] : nullptr;
+}
+
+SCBlock* SaveFile::findBlock(uint32_t key) {
+    auto it = blockIndex_.find(key);
+    if (it == blockIndex_.end())
+        return nullptr;
+    // Callers get write access, so assume the block will be modified
+    markBlockDirty(it->second);
+    if (key == KMYSTATUS_8 || key == KMYSTATUS_9)
+        trainerInfoCached_ = false;
+    return &blocks_[it->second];
+}
+
+const SCBlock* SaveFile::findBlock(uint32_t key) const {
+    auto it = blockIndex_.find(key);
+    return it != blockIndex_.end() ? &blocks_[it->second] : nullptr;
+}
+
 bool SaveFile::saveSCBlock(const std::string& path) {
-    std::vector<uint8_t> encrypted = SwishCrypto::encrypt(blocks_);
+    // Patch dirty blocks into the retained image when their encoded size
+    // is unchanged; otherwise block offsets shift and we re-encrypt it all.
+    bool incremental = !encryptedImage_.empty() && blockDirty_.size() == blocks_.size();
+    for (size_t i = 0; incremental && i < blocks_.size(); i++) {
+        if (blockDirty_[i] && blocks_[i].encodedSize() != blockOffsets_[i + 1] - blockOffsets_[i])
+            incremental = false;
+    }
+
+    // Byte ranges of the image that differ from the file at imagePath_
+    std::vector<std::pair<size_t, size_t>> ranges;
+    if (incremental) {
+        for (size_t i = 0; i < blocks_.size(); i++) {
+            if (!blockDirty_[i])
+                continue;
+            size_t len = SwishCrypto::encryptBlockAt(blocks_[i], encryptedImage_.data(), blockOffsets_[i]);
+            ranges.emplace_back(blockOffsets_[i], len);
+        }
+        if (ranges.empty() && path == imagePath_)
+            return true; // nothing changed since the last load/save
+        SwishCrypto::writeHash(encryptedImage_.data(), encryptedImage_.size());
+        ranges.emplace_back(encryptedImage_.size() - SwishCrypto::HASH_SIZE, SwishCrypto::HASH_SIZE);
+    } else {
+        encryptedImage_ = SwishCrypto::encrypt(blocks_);
+        rebuildBlockOffsets();
+    }
 
     // Open for in-place writing (r+b) to avoid truncating the file.
     // The Switch save filesystem journal can break if we truncate + rewrite.
     // Our encrypted output is always the exact same size as the original.
     FILE* f = std::fopen(path.c_str(), "r+b");
+    bool patch = incremental && path == imagePath_ && f;
     if (!f) {
-        // File doesn't exist yet — create it
+        // File doesn't exist yet (or was removed since load) — create it.
+        // A new file has none of the clean blocks, so write the whole image.
         f = std::fopen(path.c_str(), "wb");
     }
     if (!f)
         return false;
 
-    size_t written = std::fwrite(encrypted.data(), 1, encrypted.size(), f);
-    std::fclose(f);
-    return written == encrypted.size();
+    bool ok = true;
+    if (patch) {
+        for (auto& [ofs, len] : ranges) {
+            if (std::fseek(f, static_cast<long>(ofs), SEEK_SET) != 0 ||
+                std::fwrite(encryptedImage_.data() + ofs, 1, len, f) != len) {
+                ok = false;
+                break;
+            }
+        }
+    } else {
+        ok = std::fwrite(encryptedImage_.data(), 1, encryptedImage_.size(), f) == encryptedImage_.size();
+    }
+    if (std::fclose(f) != 0)
+        ok = false;
+
+    if (ok) {
+        std::fill(blockDirty_.begin(), blockDirty_.end(), 0);
+        imagePath_ = path;
+    } else {
+        // Disk contents are unknown now; force a full write next time
+        imagePath_.clear();
+    }
+    return ok;
 }
 
 bool SaveFile::loadBDSP(const std::string& path) {
@@ -168,23 +277,79 @@ bool SaveFile::saveBDSP(const std::string& path) {
 
 const std::vector<Pokemon>& SaveFile::getCachedBox(int box) const {
     auto it = boxCache_.find(box);
-    if (it != boxCache_.end())
-        return it->second;
+    if (it != boxCache_.end()) {
+        boxCacheStats_.hits++;
+        boxLru_.splice(boxLru_.begin(), boxLru_, it->second.lruPos);
+        return it->second.slots;
+    }
 
-    // Evict oldest if cache is full
-    if (static_cast<int>(boxCache_.size()) >= BOX_CACHE_MAX)
-        boxCache_.clear();
+    boxCacheStats_.misses++;
+    return decryptBoxToCache(box).slots;
+}
 
-    std::vector<Pokemon> slots(slotsPerBox_);
-    int dataSize = sizeBoxSlot_ - gapBoxSlot_;
-    for (int s = 0; s < slotsPerBox_; s++) {
-        int offset = getBoxSlotOffset(box, s);
-        if (offset + sizeBoxSlot_ > static_cast<int>(boxDataLen_))
+SaveFile::CachedBox& SaveFile::decryptBoxToCache(int box) const {
+    Profiler::Scope probe(ProfZone::BoxDecrypt);
+    // Make room first so the new entry is never the one evicted
+    evictBoxesOver(boxCacheCapacity_ - 1);
+
+    CachedBox entry;
+    entry.slots.resize(slotsPerBox_);
+    Pokemon::decryptBox(gameType_, boxData_ + getBoxOffset(box), boxSlotsInData(box),
+                        sizeBoxSlot_, gapBoxSlot_, entry.slots.data());
+    boxLru_.push_front(box);
+    entry.lruPos = boxLru_.begin();
+    return boxCache_.emplace(box, std::move(entry)).first->second;
+}
+
+void SaveFile::evictBoxesOver(int capacity) const {
+    while (!boxLru_.empty() && static_cast<int>(boxLru_.size()) > capacity) {
+        boxCache_.erase(boxLru_.back());
+        boxLru_.pop_back();
+        boxCacheStats_.evictions++;
+    }
+}
+
+void SaveFile::invalidateBoxCache(int box) const {
+    auto it = boxCache_.find(box);
+    if (it == boxCache_.end())
+        return;
+    boxLru_.erase(it->second.lruPos);
+    boxCache_.erase(it);
+}
+
+void SaveFile::setBoxCacheCapacity(int boxes) {
+    boxCacheCapacity_ = std::max(boxes, 1);
+    evictBoxesOver(boxCacheCapacity_);
+}
+
+void SaveFile::prefetchBoxesAround(int box) {
+    if (!loaded_ || !boxData_ || boxCount_ <= 1)
+        return;
+    // Prefetched boxes go in behind the current one; with fewer than three
+    // slots in the cache they would push it (or each other) straight out.
+    if (boxCacheCapacity_ < 3)
+        return;
+    prefetchQueue_.clear();
+    prefetchQueue_.push_back((box + 1) % boxCount_);
+    prefetchQueue_.push_back((box + boxCount_ - 1) % boxCount_);
+}
+
+bool SaveFile::runPrefetch() {
+    while (!prefetchQueue_.empty()) {
+        int box = prefetchQueue_.back();
+        prefetchQueue_.pop_back();
+        if (!loaded_ || !boxData_ || box < 0 || box >= boxCount_ || boxCache_.count(box))
             continue;
-        slots[s].gameType_ = gameType_;
-        slots[s].loadFromEncrypted(boxData_ + offset, dataSize);
+
+        // Rank the prefetched box just behind the one being viewed, so the
+        // viewed box stays most recently used
+        decryptBoxToCache(box);
+        if (boxLru_.size() > 1)
+            boxLru_.splice(boxLru_.begin(), boxLru_, std::next(boxLru_.begin()));
+        boxCacheStats_.prefetched++;
+        break;
     }
-    return boxCache_.emplace(box, std::move(slots)).first->second;
+    return !prefetchQueue_.empty();
 }
 
 Pokemon SaveFile::getBoxSlot(int box, int slot) const {
@@ -198,34 +363,68 @@ Pokemon SaveFile::getBoxSlot(int box, int slot) const {
 }
 
 void SaveFile::setBoxSlot(int box, int slot, Pokemon pkm) {
-    if (!loaded_ || !boxData_)
-        return;
+    setBoxSlots({{box, slot, std::move(pkm)}});
+}
 
-    int offset = getBoxSlotOffset(box, slot);
-    if (offset + sizeBoxSlot_ > static_cast<int>(boxDataLen_))
+void SaveFile::setBoxSlots(const std::vector<BoxSlotWrite>& writes) {
+    if (!loaded_ || !boxData_ || writes.empty())
         return;
 
-    // Ensure correct game type, refresh checksum, encrypt and write
-    pkm.gameType_ = gameType_;
+    std::vector<Pokemon> prepared;
+    std::vector<int> flatSlots;
+    std::vector<int> touchedBoxes;
+    prepared.reserve(writes.size());
+    flatSlots.reserve(writes.size());
 
-    // Adapt handling-trainer data to this save's trainer, like PKHeX's
-    // SetPKM -> UpdateHandler does on every Pokemon written into a save
-    if (!pkm.isEmpty()) {
-        TrainerInfo trainer = getTrainerInfo();
-        if (trainer.valid)
-            updatePokemonHandler(pkm, trainer);
+    for (const auto& w : writes) {
+        int offset = getBoxSlotOffset(w.box, w.slot);
+        if (offset + sizeBoxSlot_ > static_cast<int>(boxDataLen_))
+            continue;
+
+        // Ensure correct game type
+        Pokemon pkm = w.pkm;
+        pkm.gameType_ = gameType_;
+
+        // Adapt handling-trainer data to this save's trainer, like PKHeX's
+        // SetPKM -> UpdateHandler does on every Pokemon written into a save
+        if (!pkm.isEmpty()) {
+            const TrainerInfo& trainer = getTrainerInfo();
+            if (trainer.valid)
+                updatePokemonHandler(pkm, trainer);
+        }
+
+        prepared.push_back(std::move(pkm));
+        flatSlots.push_back(w.box * slotsPerBox_ + w.slot);
+        if (std::find(touchedBoxes.begin(), touchedBoxes.end(), w.box) == touchedBoxes.end())
+            touchedBoxes.push_back(w.box);
     }
 
-    pkm.getEncrypted(boxData_ + offset);
-    // Zero the gap bytes (if any)
-    if (gapBoxSlot_ > 0)
-        std::memset(boxData_ + offset + (sizeBoxSlot_ - gapBoxSlot_), 0, gapBoxSlot_);
+    // Refresh checksums, encrypt and write, one pass per run of consecutive
+    // slots (a whole box when placing a full box); gap bytes are zeroed
+    for (size_t i = 0; i < prepared.size();) {
+        size_t j = i + 1;
+        while (j < prepared.size() && flatSlots[j] == flatSlots[j - 1] + 1)
+            j++;
+        int first = flatSlots[i];
+        Pokemon::encryptBox(gameType_, &prepared[i], static_cast<int>(j - i),
+                            boxData_ + getBoxSlotOffset(first / slotsPerBox_, first % slotsPerBox_),
+                            sizeBoxSlot_, gapBoxSlot_);
+        i = j;
+    }
 
-    // Register in Pokedex (non-empty, non-egg Pokemon only)
-    if (!pkm.isEmpty())
-        Pokedex::registerPokemon(*this, pkm);
+    if (searchIndex_.built()) {
+        for (size_t i = 0; i < prepared.size(); i++)
+            searchIndex_.set(flatSlots[i], prepared[i]);
+    }
 
-    invalidateBoxCache(box);
+    // Register in Pokedex (empty and egg entries are skipped)
+    if (!prepared.empty())
+        Pokedex::registerPokemon(*this, prepared.data(), prepared.size());
+
+    if (!touchedBoxes.empty())
+        markBlockDirty(boxBlockIdx_);
+    for (int box : touchedBoxes)
+        invalidateBoxCache(box);
 }
 
 void SaveFile::clearBoxSlot(int box, int slot) {
@@ -251,7 +450,37 @@ void SaveFile::clearBoxSlot(int box, int slot) {
             std::memset(boxData_ + offset + (sizeBoxSlot_ - gapBoxSlot_), 0, gapBoxSlot_);
     }
 
+    markBlockDirty(boxBlockIdx_);
     invalidateBoxCache(box);
+    searchIndex_.clear(box * slotsPerBox_ + slot);
+}
+
+void SaveFile::forEachSlotParallel(const std::function<void(int, int, const Pokemon&)>& fn) const {
+    if (!loaded_ || !boxData_)
+        return;
+    TaskPool::shared().parallelFor(boxCount_, [&](int box) {
+        int count = boxSlotsInData(box);
+        std::vector<Pokemon> slots(count);
+        {
+            Profiler::Scope probe(ProfZone::BoxDecrypt);
+            Pokemon::decryptBox(gameType_, boxData_ + getBoxOffset(box), count,
+                                sizeBoxSlot_, gapBoxSlot_, slots.data());
+        }
+        for (int s = 0; s < count; s++)
+            fn(box, s, slots[s]);
+    });
+}
+
+const SearchIndex& SaveFile::searchIndex() const {
+    if (!searchIndex_.built()) {
+        searchIndex_.reset(boxCount_ * slotsPerBox_);
+        // Each slot owns its own row, so boxes can fill the index concurrently
+        forEachSlotParallel([this](int box, int slot, const Pokemon& pkm) {
+            searchIndex_.set(box * slotsPerBox_ + slot, pkm);
+        });
+        searchIndex_.markBuilt();
+    }
+    return searchIndex_;
 }
 
 bool SaveFile::isLGPEPartySlot(int box, int slot) const {
@@ -442,23 +671,24 @@ std::string SaveFile::getBoxName(int box) const {
 }
 
 std::string SaveFile::verifyRoundTrip() {
-    if (originalFileData_.empty())
+    if (blocks_.empty() || encryptedImage_.empty())
         return "No original data";
+    const std::vector<uint8_t>& original = encryptedImage_;
 
     // Re-encrypt blocks (no modifications have been made yet)
     std::vector<uint8_t> encrypted = SwishCrypto::encrypt(blocks_);
 
     std::string result;
 
-    if (encrypted.size() != originalFileData_.size()) {
+    if (encrypted.size() != original.size()) {
         result = "SIZE MISMATCH: encrypted=" + std::to_string(encrypted.size())
-               + " original=" + std::to_string(originalFileData_.size());
+               + " original=" + std::to_string(original.size());
     } else {
         // Compare byte-by-byte
         size_t diffCount = 0;
         size_t firstDiff = 0;
         for (size_t i = 0; i < encrypted.size(); i++) {
-            if (encrypted[i] != originalFileData_[i]) {
+            if (encrypted[i] != original[i]) {
                 if (diffCount == 0)
                     firstDiff = i;
                 diffCount++;
@@ -469,10 +699,10 @@ std::string SaveFile::verifyRoundTrip() {
             result = "OK";
         } else {
             // Check if the difference is only in the hash (last 32 bytes)
-            size_t hashStart = originalFileData_.size() - 32;
+            size_t hashStart = original.size() - 32;
             bool onlyHashDiffers = true;
             for (size_t i = 0; i < hashStart; i++) {
-                if (encrypted[i] != originalFileData_[i]) {
+                if (encrypted[i] != original[i]) {
                     onlyHashDiffers = false;
                     break;
                 }
@@ -486,22 +716,26 @@ std::string SaveFile::verifyRoundTrip() {
                 std::snprintf(buf, sizeof(buf),
                     "DIFF: %zu bytes differ, first at 0x%zX (enc=0x%02X orig=0x%02X)",
                     diffCount, firstDiff,
-                    encrypted[firstDiff], originalFileData_[firstDiff]);
+                    encrypted[firstDiff], original[firstDiff]);
             }
             result = buf;
         }
     }
 
-    // Free the original data
-    originalFileData_.clear();
-    originalFileData_.shrink_to_fit();
-
     return result;
 }
 
 // --- Trainer Info (for wondercard injection) ---
 
-TrainerInfo SaveFile::getTrainerInfo() const {
+const TrainerInfo& SaveFile::getTrainerInfo() const {
+    if (!trainerInfoCached_) {
+        trainerInfo_ = parseTrainerInfo();
+        trainerInfoCached_ = true;
+    }
+    return trainerInfo_;
+}
+
+TrainerInfo SaveFile::parseTrainerInfo() const {
     TrainerInfo info;
     info.valid = false;
 
@@ -577,7 +811,7 @@ TrainerInfo SaveFile::getTrainerInfo() const {
 
     if (gameType_ == GameType::LA) {
         // PLA MyStatus8a block key: 0xf25c070e (same key as SWSH, different offsets)
-        const SCBlock* block = SwishCrypto::findBlock(blocks_, 0xf25c070e);
+        const SCBlock* block = findBlock(KMYSTATUS_8);
         if (!block || block->data.size() < 0x50)
             return info;
 
@@ -607,7 +841,7 @@ TrainerInfo SaveFile::getTrainerInfo() const {
 
     if (isSwSh(gameType_)) {
         // SWSH MyStatus8 block key: 0xf25c070e
-        const SCBlock* block = SwishCrypto::findBlock(blocks_, 0xf25c070e);
+        const SCBlock* block = findBlock(KMYSTATUS_8);
         if (!block || block->data.size() < 0xCA)
             return info;
 
@@ -638,7 +872,7 @@ TrainerInfo SaveFile::getTrainerInfo() const {
     }
 
     // SV/ZA: KMyStatus block key: 0xE3E89BD1
-    const SCBlock* block = SwishCrypto::findBlock(blocks_, 0xE3E89BD1);
+    const SCBlock* block = findBlock(KMYSTATUS_9);
     if (!block || block->data.size() < 0x30)
         return info;
 
@@ -769,6 +1003,7 @@ bool SaveFile::saveLGPE(const std::string& path) {
     // Build old→new index mapping for pointer updates
     std::vector<int> oldToNew(totalSlots, -1);
     int writeIdx = 0;
+    bool moved = false;
 
     for (int i = 0; i < totalSlots; i++) {
         int offset = i * slotSize;
@@ -785,10 +1020,17 @@ bool SaveFile::saveLGPE(const std::string& path) {
         if (writeIdx != i) {
             int dstOffset = writeIdx * slotSize;
             std::memmove(boxData_ + dstOffset, boxData_ + offset, slotSize);
+            moved = true;
         }
         writeIdx++;
     }
 
+    // Cached boxes and the search index still describe the old positions
+    if (moved) {
+        invalidateAllBoxCache();
+        searchIndex_.reset(0);
+    }
+
     // Zero remaining slots after the last occupied one
     for (int i = writeIdx; i < totalSlots; i++) {
         int offset = i * slotSize;
@@ -1,10 +1,16 @@
 #include "sc_block.h"
 #include "binary_io.h"
 
-SCBlock SCBlock::readFromOffset(const uint8_t* buf, size_t bufLen, size_t& offset) {
-    SCBlock block{};
+bool SCBlock::readFromOffset(uint8_t* buf, size_t bufLen, size_t& offset, SCBlock& block) {
+    block = SCBlock{};
 
-    // Read key
+    // Every length below comes from the file, so each is checked against
+    // what is left of buf before anything is read or decrypted in place
+    auto fits = [&](size_t n) { return offset <= bufLen && n <= bufLen - offset; };
+
+    // Read key and type
+    if (!fits(4 + 1))
+        return false;
     block.key = readU32LE(buf + offset);
     offset += 4;
 
@@ -14,49 +20,55 @@ SCBlock SCBlock::readFromOffset(const uint8_t* buf, size_t bufLen, size_t& offse
     // Read and decrypt type
     block.type = static_cast<SCTypeCode>(buf[offset++] ^ xk.next());
 
+    size_t numBytes;
     switch (block.type) {
         case SCTypeCode::Bool1:
         case SCTypeCode::Bool2:
         case SCTypeCode::Bool3:
             // No data payload
-            return block;
+            return true;
 
         case SCTypeCode::Object: {
             // Read encrypted length
-            int32_t numBytes = static_cast<int32_t>(readU32LE(buf + offset) ^ static_cast<uint32_t>(xk.next32()));
+            if (!fits(4))
+                return false;
+            int32_t len = static_cast<int32_t>(readU32LE(buf + offset) ^ static_cast<uint32_t>(xk.next32()));
             offset += 4;
-            block.data.resize(numBytes);
-            for (int32_t i = 0; i < numBytes; i++)
-                block.data[i] = buf[offset + i] ^ xk.next();
-            offset += numBytes;
-            return block;
+            if (len < 0)
+                return false;
+            numBytes = static_cast<size_t>(len);
+            break;
         }
 
         case SCTypeCode::Array: {
-            // Read encrypted entry count
+            // Read encrypted entry count and sub-type
+            if (!fits(4 + 1))
+                return false;
             int32_t numEntries = static_cast<int32_t>(readU32LE(buf + offset) ^ static_cast<uint32_t>(xk.next32()));
             offset += 4;
-            // Read encrypted sub-type
             block.subType = static_cast<SCTypeCode>(buf[offset++] ^ xk.next());
             int elemSize = getTypeSize(block.subType);
-            int32_t numBytes = numEntries * elemSize;
-            block.data.resize(numBytes);
-            for (int32_t i = 0; i < numBytes; i++)
-                block.data[i] = buf[offset + i] ^ xk.next();
-            offset += numBytes;
-            return block;
+            if (numEntries < 0 || elemSize == 0)
+                return false;
+            // Done in 64 bits: a 32-bit count times an 8-byte element can't overflow
+            numBytes = static_cast<size_t>(static_cast<uint64_t>(numEntries) * elemSize);
+            break;
         }
 
-        default: {
-            // Single primitive value
-            int numBytes = getTypeSize(block.type);
-            block.data.resize(numBytes);
-            for (int i = 0; i < numBytes; i++)
-                block.data[i] = buf[offset + i] ^ xk.next();
-            offset += numBytes;
-            return block;
-        }
+        default:
+            // Single primitive value; an unknown type code has size 0
+            numBytes = getTypeSize(block.type);
+            if (numBytes == 0)
+                return false;
+            break;
     }
+
+    if (!fits(numBytes))
+        return false;
+    xk.xorBytes(buf + offset, buf + offset, numBytes);
+    block.data.setView(buf + offset, numBytes);
+    offset += numBytes;
+    return true;
 }
 
 size_t SCBlock::encodedSize() const {
@@ -108,8 +120,8 @@ size_t SCBlock::writeBlock(uint8_t* out) const {
     }
 
     // Write encrypted data bytes
-    for (size_t i = 0; i < data.size(); i++)
-        out[pos++] = data[i] ^ xk.next();
+    xk.xorBytes(out + pos, data.data(), data.size());
+    pos += data.size();
 
     return pos;
 }
@@ -0,0 +1,204 @@
+#include "search_index.h"
+#include "species_converter.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+static std::string toLower(const std::string& s) {
+    std::string out = s;
+    for (auto& c : out) c = std::tolower(static_cast<unsigned char>(c));
+    return out;
+}
+
+void SearchIndex::reset(int slotCount) {
+    built_ = false;
+    flags_.assign(slotCount, 0);
+    species_.assign(slotCount, 0);
+    form_.assign(slotCount, 0);
+    level_.assign(slotCount, 0);
+    gender_.assign(slotCount, 0);
+    perfectIVs_.assign(slotCount, 0);
+    otName_.assign(slotCount, std::string());
+    otNameLower_.assign(slotCount, std::string());
+}
+
+void SearchIndex::clear(int idx) {
+    if (idx < 0 || idx >= size())
+        return;
+    flags_[idx] = 0;
+    species_[idx] = 0;
+    form_[idx] = 0;
+    level_[idx] = 0;
+    gender_[idx] = 0;
+    perfectIVs_[idx] = 0;
+    otName_[idx].clear();
+    otNameLower_[idx].clear();
+}
+
+void SearchIndex::set(int idx, const Pokemon& pkm) {
+    if (idx < 0 || idx >= size())
+        return;
+    if (pkm.isEmpty()) {
+        clear(idx);
+        return;
+    }
+
+    uint8_t flags = FLAG_OCCUPIED;
+    if (pkm.isShiny()) flags |= FLAG_SHINY;
+    if (pkm.isEgg())   flags |= FLAG_EGG;
+    if (pkm.isAlpha()) flags |= FLAG_ALPHA;
+    for (const auto& r : pkm.getRibbonsAndMarks())
+        flags |= r.isMark ? FLAG_MARK : FLAG_RIBBON;
+    flags_[idx] = flags;
+
+    species_[idx] = pkm.species();
+    form_[idx]    = pkm.form();
+    level_[idx]   = pkm.level();
+    gender_[idx]  = pkm.gender();
+
+    int perfect = 0;
+    if (pkm.ivHp()  == 31) perfect++;
+    if (pkm.ivAtk() == 31) perfect++;
+    if (pkm.ivDef() == 31) perfect++;
+    if (pkm.ivSpe() == 31) perfect++;
+    if (pkm.ivSpA() == 31) perfect++;
+    if (pkm.ivSpD() == 31) perfect++;
+    perfectIVs_[idx] = static_cast<uint8_t>(perfect);
+
+    otName_[idx] = pkm.otName();
+    otNameLower_[idx] = toLower(otName_[idx]);
+}
+
+void SearchIndex::scan(const SearchQuery& q, std::vector<int>& out) const {
+    uint8_t required = FLAG_OCCUPIED;
+    if (q.shiny) required |= FLAG_SHINY;
+    if (q.egg)   required |= FLAG_EGG;
+    if (q.alpha) required |= FLAG_ALPHA;
+
+    // Species name filter: resolve each species ID once, not once per slot
+    // (0 = not checked yet, 1 = no match, 2 = match)
+    std::vector<uint8_t> nameMatch;
+    bool byName = q.speciesId == 0 && !q.speciesName.empty();
+
+    int n = size();
+    for (int i = 0; i < n; i++) {
+        uint8_t f = flags_[i];
+        if ((f & required) != required) continue;
+        if (q.speciesId > 0 && species_[i] != q.speciesId) continue;
+        if (q.gender >= 0 && gender_[i] != q.gender) continue;
+        if (!(f & FLAG_EGG)) {
+            if (q.levelMin > 0 && level_[i] < q.levelMin) continue;
+            if (q.levelMax > 0 && level_[i] > q.levelMax) continue;
+        }
+        if (perfectIVs_[i] < q.minPerfectIVs) continue;
+        if (q.hasRibbon && !(f & FLAG_RIBBON)) continue;
+        if (q.hasMark && !(f & FLAG_MARK)) continue;
+        if (q.hasAny && !(f & (FLAG_RIBBON | FLAG_MARK))) continue;
+
+        if (byName) {
+            uint16_t sp = species_[i];
+            if (sp >= nameMatch.size())
+                nameMatch.resize(sp + 1, 0);
+            if (nameMatch[sp] == 0) {
+                bool hit = toLower(SpeciesName::get(sp)).find(q.speciesName) != std::string::npos;
+                nameMatch[sp] = hit ? 2 : 1;
+            }
+            if (nameMatch[sp] != 2) continue;
+        }
+        if (!q.otName.empty() && otNameLower_[i].find(q.otName) == std::string::npos)
+            continue;
+
+        out.push_back(i);
+    }
+}
+
+bool SearchIndex::writeFile(const std::string& path, uint64_t stamp) const {
+    if (!built_)
+        return false;
+
+    std::vector<uint8_t> buf;
+    auto put = [&](const void* p, size_t n) {
+        const uint8_t* b = static_cast<const uint8_t*>(p);
+        buf.insert(buf.end(), b, b + n);
+    };
+
+    uint32_t slotCount = static_cast<uint32_t>(size());
+    uint32_t rowCount = 0;
+    for (uint8_t f : flags_)
+        if (f & FLAG_OCCUPIED) rowCount++;
+
+    put(FILE_MAGIC, 8);
+    put(&FILE_VERSION, 4);
+    put(&stamp, 8);
+    put(&slotCount, 4);
+    put(&rowCount, 4);
+    for (int i = 0; i < size(); i++) {
+        if (!(flags_[i] & FLAG_OCCUPIED))
+            continue;
+        uint16_t idx = static_cast<uint16_t>(i);
+        uint8_t otLen = static_cast<uint8_t>(std::min<size_t>(otName_[i].size(), 255));
+        put(&idx, 2);
+        put(&species_[i], 2);
+        uint8_t row[6] = {form_[i], level_[i], gender_[i], perfectIVs_[i], flags_[i], otLen};
+        put(row, 6);
+        put(otName_[i].data(), otLen);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+    return file.good();
+}
+
+bool SearchIndex::readFile(const std::string& path, uint64_t stamp) {
+    built_ = false;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    std::vector<uint8_t> buf((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+
+    constexpr size_t HEADER_SIZE = 28;
+    if (buf.size() < HEADER_SIZE || std::memcmp(buf.data(), FILE_MAGIC, 8) != 0)
+        return false;
+    uint32_t version, slotCount, rowCount;
+    uint64_t fileStamp;
+    std::memcpy(&version, buf.data() + 8, 4);
+    std::memcpy(&fileStamp, buf.data() + 12, 8);
+    std::memcpy(&slotCount, buf.data() + 20, 4);
+    std::memcpy(&rowCount, buf.data() + 24, 4);
+    if (version != FILE_VERSION || fileStamp != stamp || slotCount > 0x10000)
+        return false;
+
+    reset(static_cast<int>(slotCount));
+    size_t pos = HEADER_SIZE;
+    for (uint32_t r = 0; r < rowCount; r++) {
+        if (pos + 10 > buf.size())
+            return false;
+        uint16_t idx, species;
+        std::memcpy(&idx, buf.data() + pos, 2);
+        std::memcpy(&species, buf.data() + pos + 2, 2);
+        const uint8_t* row = buf.data() + pos + 4;
+        uint8_t otLen = row[5];
+        pos += 10;
+        if (idx >= slotCount || pos + otLen > buf.size())
+            return false;
+
+        species_[idx]    = species;
+        form_[idx]       = row[0];
+        level_[idx]      = row[1];
+        gender_[idx]     = row[2];
+        perfectIVs_[idx] = row[3];
+        flags_[idx]      = row[4] | FLAG_OCCUPIED;
+        otName_[idx].assign(reinterpret_cast<const char*>(buf.data() + pos), otLen);
+        otNameLower_[idx] = toLower(otName_[idx]);
+        pos += otLen;
+    }
+
+    built_ = true;
+    return true;
+}
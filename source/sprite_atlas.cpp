@@ -0,0 +1,96 @@
+#include "sprite_atlas.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static constexpr char     ATLAS_MAGIC[4] = {'P', 'K', 'A', 'T'};
+static constexpr uint16_t ATLAS_VERSION  = 1;
+static constexpr size_t   HEADER_SIZE    = 12;
+static constexpr size_t   PAGE_REC_SIZE  = 8;
+static constexpr size_t   ENTRY_SIZE     = 12;
+
+bool SpriteAtlas::load(const std::string& path, SDL_Renderer* renderer) {
+    free();
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    uint8_t hdr[HEADER_SIZE];
+    if (std::fread(hdr, 1, HEADER_SIZE, f) != HEADER_SIZE ||
+        std::memcmp(hdr, ATLAS_MAGIC, 4) != 0 ||
+        readU16LE(hdr + 4) != ATLAS_VERSION) {
+        std::fclose(f);
+        return false;
+    }
+    uint16_t pageCount  = readU16LE(hdr + 6);
+    uint32_t entryCount = readU32LE(hdr + 8);
+
+    std::vector<uint8_t> tables(pageCount * PAGE_REC_SIZE + entryCount * ENTRY_SIZE);
+    if (std::fread(tables.data(), 1, tables.size(), f) != tables.size()) {
+        std::fclose(f);
+        return false;
+    }
+
+    // Entries are written sorted by (species, form), i.e. by key
+    const uint8_t* e = tables.data() + pageCount * PAGE_REC_SIZE;
+    entries_.resize(entryCount);
+    for (uint32_t i = 0; i < entryCount; i++, e += ENTRY_SIZE) {
+        Entry& en = entries_[i];
+        en.key  = (uint32_t(readU16LE(e)) << 8) | e[2];
+        en.page = e[3];
+        en.rect = {readU16LE(e + 4), readU16LE(e + 6), readU16LE(e + 8), readU16LE(e + 10)};
+    }
+
+    // Upload each page straight from the file: RGBA8, no decode
+    std::vector<uint8_t> pixels;
+    const uint8_t* p = tables.data();
+    for (uint16_t i = 0; i < pageCount; i++, p += PAGE_REC_SIZE) {
+        int w = readU16LE(p);
+        int h = readU16LE(p + 2);
+        pixels.resize(size_t(w) * h * 4);
+        if (std::fseek(f, readU32LE(p + 4), SEEK_SET) != 0 ||
+            std::fread(pixels.data(), 1, pixels.size(), f) != pixels.size())
+            break;
+        SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                             SDL_TEXTUREACCESS_STATIC, w, h);
+        if (!tex)
+            break;
+        SDL_UpdateTexture(tex, nullptr, pixels.data(), w * 4);
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        pages_.push_back(tex);
+    }
+    std::fclose(f);
+
+    if (pages_.size() != pageCount) {
+        free();
+        return false;
+    }
+    return true;
+}
+
+void SpriteAtlas::free() {
+    for (SDL_Texture* tex : pages_)
+        SDL_DestroyTexture(tex);
+    pages_.clear();
+    entries_.clear();
+}
+
+const SpriteAtlas::Entry* SpriteAtlas::lookup(uint32_t key) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), key,
+        [](const Entry& en, uint32_t k) { return en.key < k; });
+    if (it == entries_.end() || it->key != key)
+        return nullptr;
+    return &*it;
+}
+
+SpriteRef SpriteAtlas::find(uint16_t species, uint8_t form) const {
+    const Entry* en = nullptr;
+    if (form != 0)
+        en = lookup((uint32_t(species) << 8) | form);
+    if (!en)
+        en = lookup(uint32_t(species) << 8);
+    if (!en || en->page >= pages_.size())
+        return {};
+    return {pages_[en->page], en->rect};
+}
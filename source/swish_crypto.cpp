@@ -1,6 +1,24 @@
 #include "swish_crypto.h"
+#include "profiler.h"
 #include <cstring>
 #include <algorithm>
+#include <array>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// SHA-256 backend, picked at compile time. The Switch build targets
+// armv8-a+crypto, which provides the SHA2 instructions; x86 hosts built
+// with -msha -msse4.1 use SHA-NI. Anything else uses the portable code.
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define SHA256_ARMV8 1
+#elif defined(__SHA__) && defined(__SSE4_1__)
+#define SHA256_SHANI 1
+#include <immintrin.h>
+#endif
 
 // Static XOR pad (127 usable bytes + 1 trailing zero for alignment to 128)
 // From SwishCrypto.cs lines 39-49
@@ -17,6 +35,40 @@ static const uint8_t STATIC_XORPAD[128] = {
 
 static constexpr size_t XORPAD_SIZE = 0x7F; // 127 usable bytes
 
+// The pad repeats every 127 bytes, which never lines up with a 16-byte lane.
+// Unrolling it 16 times gives a tile of lcm(127, 16) = 2032 bytes that does,
+// so the whole payload can be XORed in full vector lanes.
+static constexpr size_t XORPAD_LANE = 16;
+static constexpr size_t XORPAD_TILE = XORPAD_SIZE * XORPAD_LANE;
+
+static const uint8_t* tiledXorpad() {
+    static const std::array<uint8_t, XORPAD_TILE> tile = [] {
+        std::array<uint8_t, XORPAD_TILE> t{};
+        for (size_t i = 0; i < XORPAD_TILE; i++)
+            t[i] = STATIC_XORPAD[i % XORPAD_SIZE];
+        return t;
+    }();
+    return tile.data();
+}
+
+// XOR len bytes of data with the start of the tiled pad (len <= XORPAD_TILE).
+static void xorWithTile(uint8_t* data, const uint8_t* pad, size_t len) {
+    size_t i = 0;
+#if defined(__ARM_NEON)
+    for (; i + XORPAD_LANE <= len; i += XORPAD_LANE)
+        vst1q_u8(data + i, veorq_u8(vld1q_u8(data + i), vld1q_u8(pad + i)));
+#elif defined(__SSE2__)
+    for (; i + XORPAD_LANE <= len; i += XORPAD_LANE) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pad + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_xor_si128(d, p));
+    }
+#endif
+    // Scalar fallback (and tail)
+    for (; i < len; i++)
+        data[i] ^= pad[i];
+}
+
 // SHA256 intro/outro salts for hash computation
 // From SwishCrypto.cs lines 23-37
 static const uint8_t INTRO_HASH[64] = {
@@ -33,7 +85,7 @@ static const uint8_t OUTRO_HASH[64] = {
     0xF1, 0x26, 0xE0, 0x03, 0x0A, 0xE6, 0x6F, 0xF6, 0x41, 0xBF, 0x7E, 0x59, 0xC2, 0xAE, 0x55, 0xFD,
 };
 
-static constexpr size_t SIZE_HASH = 32; // SHA256
+static constexpr size_t SIZE_HASH = SwishCrypto::HASH_SIZE; // SHA256
 
 // Minimal SHA256 implementation for portability
 namespace {
@@ -63,6 +115,88 @@ static inline uint32_t sig1(uint32_t x) { return rotr(x,6) ^ rotr(x,11) ^ rotr(x
 static inline uint32_t gam0(uint32_t x) { return rotr(x,7) ^ rotr(x,18) ^ (x >> 3); }
 static inline uint32_t gam1(uint32_t x) { return rotr(x,17) ^ rotr(x,19) ^ (x >> 10); }
 
+#if defined(SHA256_ARMV8)
+
+// ARMv8 Cryptography Extension: 4 rounds per sha256h/sha256h2 pair, message
+// schedule via sha256su0/sha256su1. msg[g & 3] holds W[4g .. 4g+3].
+static void sha256_blocks(SHA256_CTX* ctx, const uint8_t* data, size_t nblocks) {
+    uint32x4_t state0 = vld1q_u32(&ctx->state[0]); // ABCD
+    uint32x4_t state1 = vld1q_u32(&ctx->state[4]); // EFGH
+
+    for (; nblocks > 0; nblocks--, data += 64) {
+        uint32x4_t save0 = state0, save1 = state1;
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; i++)
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+
+        for (int g = 0; g < 16; g++) {
+            uint32x4_t wk = vaddq_u32(msg[g & 3], vld1q_u32(&K256[g * 4]));
+            if (g < 12)
+                msg[g & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[g & 3], msg[(g + 1) & 3]),
+                                             msg[(g + 2) & 3], msg[(g + 3) & 3]);
+            uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, wk);
+            state1 = vsha256h2q_u32(state1, abcd, wk);
+        }
+
+        state0 = vaddq_u32(state0, save0);
+        state1 = vaddq_u32(state1, save1);
+    }
+
+    vst1q_u32(&ctx->state[0], state0);
+    vst1q_u32(&ctx->state[4], state1);
+}
+
+#elif defined(SHA256_SHANI)
+
+// x86 SHA extensions: sha256rnds2 does 2 rounds on the ABEF/CDGH state
+// halves, sha256msg1/msg2 build the schedule. msg[g & 3] holds W[4g .. 4g+3].
+static void sha256_blocks(SHA256_CTX* ctx, const uint8_t* data, size_t nblocks) {
+    const __m128i BSWAP = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ctx->state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ctx->state[4]));
+    tmp    = _mm_shuffle_epi32(tmp, 0xB1);          // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);       // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);    // CDGH
+
+    for (; nblocks > 0; nblocks--, data += 64) {
+        __m128i save0 = state0, save1 = state1;
+        __m128i msg[4];
+        for (int i = 0; i < 4; i++)
+            msg[i] = _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), BSWAP);
+
+        for (int g = 0; g < 16; g++) {
+            __m128i wk = _mm_add_epi32(msg[g & 3],
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K256[g * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            if (g >= 3 && g <= 14) {
+                __m128i& next = msg[(g + 1) & 3];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(msg[g & 3], msg[(g - 1) & 3], 4));
+                next = _mm_sha256msg2_epu32(next, msg[g & 3]);
+            }
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+            if (g >= 1 && g <= 12)
+                msg[(g - 1) & 3] = _mm_sha256msg1_epu32(msg[(g - 1) & 3], msg[g & 3]);
+        }
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+    }
+
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);       // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);    // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);       // HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&ctx->state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&ctx->state[4]), state1);
+}
+
+#else
+
 static void sha256_transform(SHA256_CTX* ctx, const uint8_t* data) {
     uint32_t w[64];
     for (int i = 0; i < 16; i++)
@@ -84,6 +218,13 @@ static void sha256_transform(SHA256_CTX* ctx, const uint8_t* data) {
     ctx->state[4]+=e; ctx->state[5]+=f; ctx->state[6]+=g; ctx->state[7]+=h;
 }
 
+static void sha256_blocks(SHA256_CTX* ctx, const uint8_t* data, size_t nblocks) {
+    for (; nblocks > 0; nblocks--, data += 64)
+        sha256_transform(ctx, data);
+}
+
+#endif
+
 static void sha256_init(SHA256_CTX* ctx) {
     ctx->state[0]=0x6a09e667; ctx->state[1]=0xbb67ae85;
     ctx->state[2]=0x3c6ef372; ctx->state[3]=0xa54ff53a;
@@ -103,11 +244,14 @@ static void sha256_update(SHA256_CTX* ctx, const uint8_t* data, size_t len) {
         std::memcpy(ctx->buffer + bufIdx, data, toCopy);
         i = toCopy;
         if (bufIdx + toCopy == 64) {
-            sha256_transform(ctx, ctx->buffer);
+            sha256_blocks(ctx, ctx->buffer, 1);
         }
     }
-    for (; i + 64 <= len; i += 64)
-        sha256_transform(ctx, data + i);
+    if (len - i >= 64) {
+        size_t nblocks = (len - i) / 64;
+        sha256_blocks(ctx, data + i, nblocks);
+        i += nblocks * 64;
+    }
     if (i < len)
         std::memcpy(ctx->buffer, data + i, len - i);
 }
@@ -117,14 +261,14 @@ static void sha256_final(SHA256_CTX* ctx, uint8_t hash[32]) {
     ctx->buffer[bufIdx++] = 0x80;
     if (bufIdx > 56) {
         std::memset(ctx->buffer + bufIdx, 0, 64 - bufIdx);
-        sha256_transform(ctx, ctx->buffer);
+        sha256_blocks(ctx, ctx->buffer, 1);
         bufIdx = 0;
     }
     std::memset(ctx->buffer + bufIdx, 0, 56 - bufIdx);
     uint64_t bits = ctx->bitcount;
     for (int i = 7; i >= 0; i--)
         ctx->buffer[56 + (7 - i)] = static_cast<uint8_t>(bits >> (i * 8));
-    sha256_transform(ctx, ctx->buffer);
+    sha256_blocks(ctx, ctx->buffer, 1);
     for (int i = 0; i < 8; i++) {
         hash[i*4+0] = static_cast<uint8_t>(ctx->state[i] >> 24);
         hash[i*4+1] = static_cast<uint8_t>(ctx->state[i] >> 16);
@@ -136,6 +280,7 @@ static void sha256_final(SHA256_CTX* ctx, uint8_t hash[32]) {
 } // anonymous namespace
 
 static void computeHash(const uint8_t* payload, size_t payloadLen, uint8_t out[32]) {
+    Profiler::Scope probe(ProfZone::SwishHash);
     SHA256_CTX ctx;
     sha256_init(&ctx);
     sha256_update(&ctx, INTRO_HASH, 64);
@@ -144,20 +289,46 @@ static void computeHash(const uint8_t* payload, size_t payloadLen, uint8_t out[3
     sha256_final(&ctx, out);
 }
 
-void SwishCrypto::cryptStaticXorpadBytes(uint8_t* data, size_t len) {
+void SwishCrypto::sha256(const std::vector<std::pair<const uint8_t*, size_t>>& parts,
+                         uint8_t out[HASH_SIZE]) {
+    SHA256_CTX ctx;
+    sha256_init(&ctx);
+    for (const auto& part : parts)
+        sha256_update(&ctx, part.first, part.second);
+    sha256_final(&ctx, out);
+}
+
+const char* SwishCrypto::sha256Backend() {
+#if defined(SHA256_ARMV8)
+    return "armv8";
+#elif defined(SHA256_SHANI)
+    return "sha-ni";
+#else
+    return "portable";
+#endif
+}
+
+void SwishCrypto::cryptStaticXorpadBytes(uint8_t* data, size_t len, size_t padOffset) {
+    size_t phase = padOffset % XORPAD_SIZE;
+    const uint8_t* pad = tiledXorpad() + phase;
+    // Process in chunks that are a multiple of 127 so every chunk starts at
+    // the same pad phase: the full 2032-byte tile when aligned, otherwise
+    // 15 * 127 bytes, which still fits in the tile after the phase shift.
+    size_t chunk = phase ? XORPAD_TILE - XORPAD_SIZE : XORPAD_TILE;
     size_t i = 0;
-    // Process in chunks of XORPAD_SIZE (127 bytes)
-    while (i + XORPAD_SIZE <= len) {
-        for (size_t j = 0; j < XORPAD_SIZE; j++)
-            data[i + j] ^= STATIC_XORPAD[j];
-        i += XORPAD_SIZE;
+    while (i + chunk <= len) {
+        xorWithTile(data + i, pad, chunk);
+        i += chunk;
     }
-    // Remainder
-    for (size_t j = 0; i + j < len; j++)
-        data[i + j] ^= STATIC_XORPAD[j];
+    // Remainder starts on the same phase, so the tile prefix still lines up
+    xorWithTile(data + i, pad, len - i);
 }
 
-std::vector<SCBlock> SwishCrypto::decrypt(uint8_t* fileData, size_t fileSize) {
+bool SwishCrypto::decrypt(uint8_t* fileData, size_t fileSize, std::vector<SCBlock>& blocks) {
+    Profiler::Scope probe(ProfZone::SwishCrypt);
+    blocks.clear();
+    if (fileSize < SIZE_HASH)
+        return false;
     // Ignore last 32 bytes (SHA256 hash)
     size_t payloadLen = fileSize - SIZE_HASH;
 
@@ -165,17 +336,22 @@ std::vector<SCBlock> SwishCrypto::decrypt(uint8_t* fileData, size_t fileSize) {
     cryptStaticXorpadBytes(fileData, payloadLen);
 
     // Parse blocks sequentially
-    std::vector<SCBlock> blocks;
     blocks.reserve(payloadLen / 500); // rough estimate
     size_t offset = 0;
     while (offset < payloadLen) {
-        blocks.push_back(SCBlock::readFromOffset(fileData, payloadLen, offset));
+        SCBlock block;
+        if (!SCBlock::readFromOffset(fileData, payloadLen, offset, block)) {
+            blocks.clear();
+            return false;
+        }
+        blocks.push_back(std::move(block));
     }
 
-    return blocks;
+    return true;
 }
 
 std::vector<uint8_t> SwishCrypto::encrypt(const std::vector<SCBlock>& blocks) {
+    Profiler::Scope probe(ProfZone::SwishCrypt);
     // Calculate total size
     size_t totalSize = 0;
     for (auto& b : blocks)
@@ -201,6 +377,17 @@ std::vector<uint8_t> SwishCrypto::encrypt(const std::vector<SCBlock>& blocks) {
     return result;
 }
 
+size_t SwishCrypto::encryptBlockAt(const SCBlock& block, uint8_t* fileData, size_t offset) {
+    size_t len = block.writeBlock(fileData + offset);
+    cryptStaticXorpadBytes(fileData + offset, len, offset);
+    return len;
+}
+
+void SwishCrypto::writeHash(uint8_t* fileData, size_t fileSize) {
+    size_t payloadLen = fileSize - SIZE_HASH;
+    computeHash(fileData, payloadLen, fileData + payloadLen);
+}
+
 SCBlock* SwishCrypto::findBlock(std::vector<SCBlock>& blocks, uint32_t key) {
     for (auto& b : blocks) {
         if (b.key == key)
@@ -0,0 +1,109 @@
+#include "task_pool.h"
+#include <algorithm>
+
+#ifdef __SWITCH__
+#include <switch.h>
+#endif
+
+TaskPool& TaskPool::shared() {
+#ifdef __SWITCH__
+    static TaskPool pool(2);
+#else
+    static TaskPool pool(std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+#endif
+    return pool;
+}
+
+TaskPool::TaskPool(int workers)
+    : shares_(new Share[workers + 1]) {
+    workers_.reserve(workers);
+    for (int i = 0; i < workers; i++)
+        workers_.emplace_back(&TaskPool::workerMain, this, i + 1);
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : workers_)
+        t.join();
+}
+
+void TaskPool::parallelFor(int count, const std::function<void(int)>& fn) {
+    if (count <= 0)
+        return;
+    int n = concurrency();
+    if (n == 1 || count == 1) {
+        for (int i = 0; i < count; i++)
+            fn(i);
+        return;
+    }
+
+    // The shares and job_ belong to one caller at a time
+    std::lock_guard<std::mutex> call(callMutex_);
+
+    // Contiguous shares, the first (count % n) one item larger
+    int base = count / n, extra = count % n, pos = 0;
+    for (int p = 0; p < n; p++) {
+        int len = base + (p < extra ? 1 : 0);
+        shares_[p].next.store(pos, std::memory_order_relaxed);
+        shares_[p].end = pos + len;
+        pos += len;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        running_ = static_cast<int>(workers_.size());
+        generation_++;
+    }
+    wake_.notify_all();
+
+    runShares(0);
+
+    // fn must stay alive until every worker has left it
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return running_ == 0; });
+    job_ = nullptr;
+}
+
+void TaskPool::runShares(int self) {
+    const auto& fn = *job_;
+    int n = concurrency();
+
+    // Own share first, then steal from the others in turn
+    for (int k = 0; k < n; k++) {
+        Share& share = shares_[(self + k) % n];
+        for (;;) {
+            int i = share.next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= share.end)
+                break;
+            fn(i);
+        }
+    }
+}
+
+void TaskPool::workerMain(int index) {
+#ifdef __SWITCH__
+    // Application cores are 0-2; the main thread stays on core 0
+    svcSetThreadCoreMask(threadGetCurHandle(), index, 1u << index);
+#endif
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_)
+                return;
+            seen = generation_;
+        }
+
+        runShares(index);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--running_ == 0)
+            done_.notify_one();
+    }
+}
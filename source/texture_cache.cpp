@@ -0,0 +1,66 @@
+#include "texture_cache.h"
+
+static size_t textureBytes(SDL_Texture* tex) {
+    int w = 0, h = 0;
+    if (!tex || SDL_QueryTexture(tex, nullptr, nullptr, &w, &h) != 0)
+        return 0;
+    return size_t(w) * size_t(h) * 4;
+}
+
+SDL_Texture* TextureCache::get(const std::string& key, const Loader& load) {
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        return it->second.tex;
+    }
+
+    SDL_Texture* tex = load();
+    size_t bytes = textureBytes(tex);
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{tex, bytes, lru_.begin()});
+    if (tex) {
+        bytes_ += bytes;
+        textures_++;
+        evictToBudget(key);
+    }
+    return tex;
+}
+
+void TextureCache::evictToBudget(const std::string& keep) {
+    // Oldest first; null entries are free and stay as negative results
+    auto it = lru_.end();
+    while (bytes_ > budget_ && it != lru_.begin()) {
+        --it;
+        if (*it == keep)
+            continue;
+        auto e = entries_.find(*it);
+        if (!e->second.tex)
+            continue;
+        SDL_DestroyTexture(e->second.tex);
+        bytes_ -= e->second.bytes;
+        textures_--;
+        evictions_++;
+        entries_.erase(e);
+        it = lru_.erase(it);
+    }
+}
+
+void TextureCache::clear() {
+    for (auto& [key, e] : entries_) {
+        if (e.tex)
+            SDL_DestroyTexture(e.tex);
+    }
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+    textures_ = 0;
+}
+
+TextureCache::Stats TextureCache::stats() const {
+    Stats s;
+    s.bytes     = bytes_;
+    s.budget    = budget_;
+    s.textures  = textures_;
+    s.evictions = evictions_;
+    return s;
+}
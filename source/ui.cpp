@@ -2,12 +2,15 @@
 #include "ui_util.h"
 #include "led.h"
 #include "i18n.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 #include <sys/stat.h>
 #include <sys/statvfs.h>
+#include <thread>
 
 #include <switch.h>
 
@@ -15,13 +18,7 @@ bool UI::init() {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER) < 0)
         return false;
 
-    if (TTF_Init() < 0) {
-        SDL_Quit();
-        return false;
-    }
-
     if ((IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) & IMG_INIT_PNG) == 0) {
-        TTF_Quit();
         SDL_Quit();
         return false;
     }
@@ -31,17 +28,17 @@ bool UI::init() {
         SCREEN_W, SCREEN_H, SDL_WINDOW_SHOWN);
     if (!window_) {
         IMG_Quit();
-        TTF_Quit();
         SDL_Quit();
         return false;
     }
 
+    // Sprites share atlas pages, so consecutive copies batch into one draw
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
     renderer_ = SDL_CreateRenderer(window_, -1,
         SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (!renderer_) {
         SDL_DestroyWindow(window_);
         IMG_Quit();
-        TTF_Quit();
         SDL_Quit();
         return false;
     }
@@ -52,24 +49,23 @@ bool UI::init() {
     // NOTE: PlSharedFontType_Standard covers Latin, Cyrillic, and Japanese glyphs.
     // Korean (PlSharedFontType_KO) and Chinese (PlSharedFontType_ChineseSimplified /
     // PlSharedFontType_ChineseTraditional) require loading separate system fonts.
-    // SDL_ttf does not support font fallback chains, so supporting these languages
-    // would require switching the primary font based on the active language.
+    // GlyphFont has no fallback chain, so supporting these languages would
+    // require switching the primary font based on the active language.
     PlFontData fontData;
     plInitialize(PlServiceType_System);
     plGetSharedFontByType(&fontData, PlSharedFontType_Standard);
-    SDL_RWops* rw = SDL_RWFromMem(fontData.address, fontData.size);
-    font_ = TTF_OpenFontRW(rw, 0, 18);
-    fontSmall_ = TTF_OpenFontRW(SDL_RWFromMem(fontData.address, fontData.size), 0, 14);
-    fontLarge_ = TTF_OpenFontRW(SDL_RWFromMem(fontData.address, fontData.size), 0, 28);
+    font_      = GlyphFont::fromMemory(renderer_, fontData.address, fontData.size, 18);
+    fontSmall_ = GlyphFont::fromMemory(renderer_, fontData.address, fontData.size, 14);
+    fontLarge_ = GlyphFont::fromMemory(renderer_, fontData.address, fontData.size, 28);
 
     if (!font_ || !fontSmall_) {
         if (!font_)
-            font_ = TTF_OpenFont("romfs:/fonts/default.ttf", 18);
+            font_ = GlyphFont::fromFile(renderer_, "romfs:/fonts/default.ttf", 18);
         if (!fontSmall_)
-            fontSmall_ = TTF_OpenFont("romfs:/fonts/default.ttf", 14);
+            fontSmall_ = GlyphFont::fromFile(renderer_, "romfs:/fonts/default.ttf", 14);
     }
     if (!fontLarge_)
-        fontLarge_ = TTF_OpenFont("romfs:/fonts/default.ttf", 28);
+        fontLarge_ = GlyphFont::fromFile(renderer_, "romfs:/fonts/default.ttf", 28);
 
     // Load status icons
     {
@@ -90,6 +86,9 @@ bool UI::init() {
         iconBoxNonEmpty_ = loadIcon("box_nonempty.png");
     }
 
+    // Pokemon sprite atlases (falls back to loose PNGs if missing)
+    loadSpriteAtlases();
+
     // Open game controller
     for (int i = 0; i < SDL_NumJoysticks(); i++) {
         if (SDL_IsGameController(i)) {
@@ -98,6 +97,9 @@ bool UI::init() {
         }
     }
 
+    // L3 / R3 diagnostics, handled before any screen sees the event
+    SDL_SetEventFilter(perfEventFilter, this);
+
     // Set default theme (persisted selection loaded in run())
     theme_ = &getTheme(0);
 
@@ -105,18 +107,18 @@ bool UI::init() {
 }
 
 void UI::shutdown() {
-    clearTextCache();
+    stopBankCountScan();
+    stopDiskSearch();
     freeGameIcons();
     account_.freeTextures();
     freeSprites();
-    if (fontLarge_) TTF_CloseFont(fontLarge_);
-    if (fontSmall_) TTF_CloseFont(fontSmall_);
-    if (font_) TTF_CloseFont(font_);
+    delete fontLarge_;
+    delete fontSmall_;
+    delete font_;
     if (pad_) SDL_GameControllerClose(pad_);
     if (renderer_) SDL_DestroyRenderer(renderer_);
     if (window_) SDL_DestroyWindow(window_);
     IMG_Quit();
-    TTF_Quit();
     SDL_Quit();
     plExit();
 }
@@ -266,7 +268,14 @@ bool UI::showConfirmDialog(const std::string& title, const std::string& body) {
 void UI::showWorking(const std::string& msg) {
     if (!renderer_) return;
     markDirty(); // Force redraw after modal returns
+    drawWorkingCard(msg, 0.0, -1.0f);
+    SDL_RenderPresent(renderer_);
+}
 
+// Gear card used by showWorking() and the save pipeline. `spin` turns the
+// gear (radians); a progress bar in [0, 1] is drawn under it unless
+// `progress` is negative.
+void UI::drawWorkingCard(const std::string& msg, double spin, float progress) {
     SDL_SetRenderDrawColor(renderer_, T().bg.r, T().bg.g, T().bg.b, 255);
     SDL_RenderClear(renderer_);
 
@@ -301,7 +310,7 @@ void UI::showWorking(const std::string& msg) {
     SDL_Color gearColor = T().arrow;
     SDL_SetRenderDrawColor(renderer_, gearColor.r, gearColor.g, gearColor.b, gearColor.a);
     for (int i = 0; i < TEETH; i++) {
-        double angle = i * (3.14159265 * 2.0 / TEETH);
+        double angle = spin + i * (3.14159265 * 2.0 / TEETH);
         int tx = gearCX + static_cast<int>((INNER_R + TOOTH_H / 2) * std::cos(angle));
         int ty = gearCY + static_cast<int>((INNER_R + TOOTH_H / 2) * std::sin(angle));
         SDL_Rect tooth = {tx - TOOTH_W / 2, ty - TOOTH_W / 2, TOOTH_W, TOOTH_W};
@@ -317,7 +326,106 @@ void UI::showWorking(const std::string& msg) {
     // Message text below gear
     drawTextCentered(msg, SCREEN_W / 2, popY + POP_H - 32, T().text, font_);
 
-    SDL_RenderPresent(renderer_);
+    if (progress >= 0.0f) {
+        constexpr int BAR_INSET = 40;
+        constexpr int BAR_H = 6;
+        int barW = POP_W - BAR_INSET * 2;
+        int barY = popY + POP_H - 14;
+        drawRect(popX + BAR_INSET, barY, barW, BAR_H, T().textDim);
+        int fill = static_cast<int>(barW * std::min(progress, 1.0f));
+        if (fill > 0)
+            drawRect(popX + BAR_INSET, barY, fill, BAR_H, T().arrow);
+    }
+}
+
+void UI::runSaveSteps(const std::vector<SaveStep>& steps) {
+    if (steps.empty())
+        return;
+    markDirty(); // Force redraw after the pipeline returns
+
+    // Steps done so far; the worker publishes, the loop below only reads
+    std::atomic<int> done{0};
+    std::thread worker([&] {
+        for (const auto& step : steps) {
+            step.run();
+            done.fetch_add(1, std::memory_order_release);
+        }
+    });
+
+    ledBlink();
+    int total = static_cast<int>(steps.size());
+    uint32_t start = SDL_GetTicks();
+    for (;;) {
+        int finished = done.load(std::memory_order_acquire);
+        // Input stays disabled: drain events so the queue doesn't back up
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {}
+
+        if (finished >= total)
+            break;
+        double spin = (SDL_GetTicks() - start) * 0.004;
+        drawWorkingCard(i18n::get(steps[finished].label), spin,
+                        static_cast<float>(finished) / total);
+        SDL_RenderPresent(renderer_);
+        SDL_Delay(16);
+    }
+    worker.join();
+    ledOff();
+}
+
+int UI::perfEventFilter(void* userdata, SDL_Event* event) {
+    if (event->type != SDL_CONTROLLERBUTTONDOWN && event->type != SDL_CONTROLLERBUTTONUP)
+        return 1;
+    Uint8 button = event->cbutton.button;
+    if (button != SDL_CONTROLLER_BUTTON_LEFTSTICK && button != SDL_CONTROLLER_BUTTON_RIGHTSTICK)
+        return 1;
+
+    // Both presses are consumed here; releases are dropped with them
+    if (event->type == SDL_CONTROLLERBUTTONDOWN) {
+        UI* ui = static_cast<UI*>(userdata);
+        if (button == SDL_CONTROLLER_BUTTON_LEFTSTICK) {
+            ui->showPerfOverlay_ = !ui->showPerfOverlay_;
+            Profiler::setEnabled(ui->showPerfOverlay_);
+        } else {
+            ui->traceDumpRequested_ = true;
+        }
+        ui->markDirty();
+    }
+    return 0;
+}
+
+void UI::presentFrame() {
+    if (showPerfOverlay_ || !perfNotice_.empty())
+        drawPerfOverlay();
+    {
+        Profiler::Scope probe(ProfZone::Present);
+        SDL_RenderPresent(renderer_);
+    }
+    Profiler::frameMark();
+    if (showPerfOverlay_) {
+        perfHistory_[perfHistoryPos_] = static_cast<float>(Profiler::lastFrame().frameMs);
+        perfHistoryPos_ = (perfHistoryPos_ + 1) % PERF_HISTORY;
+    }
+}
+
+void UI::dumpTrace() {
+    perfNoticeUntil_ = SDL_GetTicks() + 4000;
+    if (Profiler::eventCount() == 0) {
+        perfNotice_ = i18n::get(StrKey::TraceEmpty);
+        return;
+    }
+
+    time_t now = time(nullptr);
+    struct tm* t = localtime(&now);
+    char name[64];
+    std::snprintf(name, sizeof(name), "trace_%04d-%02d-%02d_%02d-%02d-%02d.json",
+                  t->tm_year + 1900, t->tm_mon + 1, t->tm_mday,
+                  t->tm_hour, t->tm_min, t->tm_sec);
+    std::string path = basePath_ + name;
+    if (Profiler::writeChromeTrace(path))
+        perfNotice_ = i18n::fmt(StrKey::TraceSaved, path);
+    else
+        perfNotice_ = i18n::fmt(StrKey::TraceWriteFailed, path);
 }
 
 void UI::run(const std::string& basePath, const std::string& savePath) {
@@ -361,6 +469,18 @@ void UI::run(const std::string& basePath, const std::string& savePath) {
     bool running = true;
 
     while (running) {
+        if (traceDumpRequested_) {
+            traceDumpRequested_ = false;
+            dumpTrace();
+        }
+        // Live timings need a fresh frame every iteration
+        if (showPerfOverlay_)
+            markDirty();
+        if (!perfNotice_.empty() && SDL_TICKS_PASSED(SDL_GetTicks(), perfNoticeUntil_)) {
+            perfNotice_.clear();
+            markDirty();
+        }
+
         // About popup intercepts input from any screen
         if (showAbout_) {
             SDL_Event event;
@@ -374,14 +494,13 @@ void UI::run(const std::string& basePath, const std::string& savePath) {
             }
             if (!showAbout_) continue; // dismissed — let main draw section handle it
             if (dirty_) {
-                if (theme_ != lastTheme_) { clearTextCache(); lastTheme_ = theme_; }
                 // Draw the underlying screen, then about popup on top
                 if (screen_ == AppScreen::ProfileSelector) drawProfileSelectorFrame();
                 else if (screen_ == AppScreen::GameSelector) drawGameSelectorFrame();
                 else if (screen_ == AppScreen::BankSelector) drawBankSelectorFrame();
                 else drawFrame();
                 drawAboutPopup();
-                SDL_RenderPresent(renderer_);
+                presentFrame();
                 dirty_ = false;
             }
             SDL_Delay(16);
@@ -442,14 +561,13 @@ void UI::run(const std::string& basePath, const std::string& savePath) {
             }
             if (!showThemeSelector_) continue; // dismissed — let main draw section handle it
             if (dirty_) {
-                if (theme_ != lastTheme_) { clearTextCache(); lastTheme_ = theme_; }
                 // Draw the underlying screen, then theme popup on top
                 if (screen_ == AppScreen::ProfileSelector) drawProfileSelectorFrame();
                 else if (screen_ == AppScreen::GameSelector) drawGameSelectorFrame();
                 else if (screen_ == AppScreen::BankSelector) drawBankSelectorFrame();
                 else drawFrame();
                 drawThemeSelectorPopup();
-                SDL_RenderPresent(renderer_);
+                presentFrame();
                 dirty_ = false;
             }
             SDL_Delay(16);
@@ -482,7 +600,6 @@ void UI::run(const std::string& basePath, const std::string& savePath) {
                         case SDL_CONTROLLER_BUTTON_B: { // Switch A = confirm
                             std::string newLang = langList_[langSelCursor_];
                             i18n::init(newLang);
-                            clearTextCache();
                             // Persist choice
                             std::string path = basePath_ + "language.txt";
                             FILE* f = std::fopen(path.c_str(), "w");
@@ -512,19 +629,25 @@ void UI::run(const std::string& basePath, const std::string& savePath) {
             }
             if (!showLanguageSelector_) continue;
             if (dirty_) {
-                if (theme_ != lastTheme_) { clearTextCache(); lastTheme_ = theme_; }
                 if (screen_ == AppScreen::ProfileSelector) drawProfileSelectorFrame();
                 else if (screen_ == AppScreen::GameSelector) drawGameSelectorFrame();
                 else if (screen_ == AppScreen::BankSelector) drawBankSelectorFrame();
                 else drawFrame();
                 drawLanguageSelectorPopup();
-                SDL_RenderPresent(renderer_);
+                presentFrame();
                 dirty_ = false;
             }
             SDL_Delay(16);
             continue;
         }
 
+        // Bank counts arriving from the worker repaint the game cards
+        if (collectBankCounts() && screen_ == AppScreen::GameSelector)
+            markDirty();
+        // Disk bank matches stream into the open results popup
+        if (collectDiskSearch() && showSearchResults_)
+            markDirty();
+
         AppScreen screenBefore = screen_;
         if (screen_ == AppScreen::ProfileSelector) {
             handleProfileSelectorInput(running);
@@ -535,20 +658,9 @@ void UI::run(const std::string& basePath, const std::string& savePath) {
         } else {
             handleInput(running);
             if (saveNow_) {
-                if (!saveBankFiles()) {
-                    saveNow_ = false;
+                if (!saveAllFiles())
                     running = true;
-                } else {
-                    if (!isDualBankMode()) {
-                        showWorking(i18n::get(StrKey::Saving));
-                        ledBlink();
-                        if (save_.isLoaded())
-                            save_.save(savePath_);
-                        account_.commitSave();
-                        ledOff();
-                    }
-                    saveNow_ = false;
-                }
+                saveNow_ = false;
             }
         }
         // Screen transition always triggers redraw
@@ -557,17 +669,19 @@ void UI::run(const std::string& basePath, const std::string& savePath) {
         // If a popup just activated, skip drawing here — the popup branch
         // will handle it next iteration with dirty_ still set.
         if (dirty_ && !showAbout_ && !showThemeSelector_ && !showLanguageSelector_) {
-            if (theme_ != lastTheme_) {
-                clearTextCache();
-                lastTheme_ = theme_;
-            }
             if (screen_ == AppScreen::ProfileSelector) drawProfileSelectorFrame();
             else if (screen_ == AppScreen::GameSelector) drawGameSelectorFrame();
             else if (screen_ == AppScreen::BankSelector) drawBankSelectorFrame();
             else drawFrame();
-            SDL_RenderPresent(renderer_);
+            presentFrame();
             dirty_ = false;
         }
+        // Boxes are read lazily while drawing; say so if the file was gone
+        if (screen_ == AppScreen::MainView)
+            reportBankReadError();
+        // Idle time: decrypt a queued neighbour box (see prefetchBoxesAround)
+        if (save_.isLoaded())
+            save_.runPrefetch();
         SDL_Delay(16);
     }
 
@@ -677,15 +791,66 @@ std::string UI::buildBackupDir(GameType game) const {
     return dir;
 }
 
+// bankFailed is written by the worker and read after runSaveSteps() joins it
+void UI::addBankSaveSteps(std::vector<SaveStep>& steps, bool& bankFailed) {
+    if (isDualBankMode() && !leftBankPath_.empty())
+        steps.push_back({StrKey::SavingBanks, [this, &bankFailed] {
+            if (!bankLeft_.save(leftBankPath_)) bankFailed = true;
+        }});
+    if (!activeBankPath_.empty())
+        steps.push_back({StrKey::SavingBanks, [this, &bankFailed] {
+            if (!bank_.save(activeBankPath_)) bankFailed = true;
+        }});
+}
+
 bool UI::saveBankFiles() {
-    showWorking(i18n::get(StrKey::Saving));
-    ledBlink();
-    if (isDualBankMode()) {
-        if (!leftBankPath_.empty()) bankLeft_.save(leftBankPath_);
-        if (!activeBankPath_.empty()) bank_.save(activeBankPath_);
-    } else {
-        if (!activeBankPath_.empty()) bank_.save(activeBankPath_);
+    std::vector<SaveStep> steps;
+    bool bankFailed = false;
+    addBankSaveSteps(steps, bankFailed);
+    runSaveSteps(steps);
+    if (bankFailed) {
+        showMessageAndWait(i18n::get(StrKey::BankSaveFailed), i18n::get(StrKey::BankSaveFailedBody));
+        return false;
     }
-    ledOff();
     return true;
 }
+
+bool UI::saveAllFiles() {
+    std::vector<SaveStep> steps;
+    bool bankFailed = false;
+    addBankSaveSteps(steps, bankFailed);
+    if (!isDualBankMode()) {
+        // Pokemon moved into a bank that failed to save must stay in the game
+        // save, so it is only written (and committed) after the banks are
+        if (save_.isLoaded())
+            steps.push_back({StrKey::SavingGameData, [this, &bankFailed] {
+                if (!bankFailed) save_.save(savePath_);
+            }});
+        steps.push_back({StrKey::CommittingSave, [this, &bankFailed] {
+            if (!bankFailed) account_.commitSave();
+        }});
+    }
+    runSaveSteps(steps);
+    if (isLGPE(selectedGame_) && save_.isLoaded()) {
+        // Saving compacts LGPE storage, moving Pokemon to lower slots
+        invalidateAllSlotDisplays();
+        refreshHighlightSet();
+    }
+    if (bankFailed) {
+        showMessageAndWait(i18n::get(StrKey::BankSaveFailed), i18n::get(StrKey::BankSaveFailedBody));
+        return false;
+    }
+    return true;
+}
+
+void UI::reportBankReadError() {
+    bool failed = bank_.sourceError() || (isDualBankMode() && bankLeft_.sourceError());
+    if (!failed) {
+        bankReadErrorShown_ = false;
+        return;
+    }
+    if (bankReadErrorShown_)
+        return;
+    bankReadErrorShown_ = true;
+    showMessageAndWait(i18n::get(StrKey::BankReadError), i18n::get(StrKey::BankReadErrorBody));
+}
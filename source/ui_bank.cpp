@@ -11,6 +11,7 @@
 // --- Bank Selector ---
 
 void UI::drawBankSelectorFrame() {
+    Profiler::Scope probe(ProfZone::Draw);
     SDL_SetRenderDrawColor(renderer_, T().bg.r, T().bg.g, T().bg.b, 255);
     SDL_RenderClear(renderer_);
 
@@ -164,7 +165,7 @@ void UI::drawBankSelectorFrame() {
                 drawText(gameName, LIST_X + 10, rowY + HDR_H / 2 - 7,
                          T().text, fontSmall_);
                 // Separator line after the text
-                int textW = getTextEntry(gameName, fontSmall_, T().text).w;
+                int textW = measureText(gameName, fontSmall_).w;
                 drawRect(LIST_X + 10 + textW + 10, rowY + HDR_H / 2,
                          LIST_W - 30 - textW, 1, T().text);
             } else {
@@ -185,8 +186,8 @@ void UI::drawBankSelectorFrame() {
                                isBDSP(banks[idx].game) ? 1200 : 960;
                 std::string slotStr = std::to_string(banks[idx].occupiedSlots) +
                                       "/" + std::to_string(maxSlots);
-                const auto& se = getTextEntry(slotStr, font_, T().textDim);
-                if (se.tex)
+                TextExtent se = measureText(slotStr, font_);
+                if (se.w > 0)
                     drawText(slotStr, LIST_X + LIST_W - 20 - se.w,
                              rowY + (ROW_H - 4) / 2 - 9, T().textDim, font_);
             }
@@ -229,8 +230,8 @@ void UI::drawBankSelectorFrame() {
             // Slot count (right-aligned)
             int maxSlots = isLGPE(selectedGame_) ? 1000 : isBDSP(selectedGame_) ? 1200 : 960;
             std::string slotStr = std::to_string(banks[idx].occupiedSlots) + "/" + std::to_string(maxSlots);
-            const auto& se = getTextEntry(slotStr, font_, T().textDim);
-            if (se.tex) drawText(slotStr, LIST_X + LIST_W - 20 - se.w, rowY + (ROW_H - 4) / 2 - 9,
+            TextExtent se = measureText(slotStr, font_);
+            if (se.w > 0) drawText(slotStr, LIST_X + LIST_W - 20 - se.w, rowY + (ROW_H - 4) / 2 - 9,
                      T().textDim, font_);
         }
     }
@@ -254,8 +255,8 @@ void UI::drawBankSelectorFrame() {
                 label = account_.profiles()[selectedProfile_].nickname + " | ";
             label += gameDisplayNameOf(selectedGame_);
         }
-        const auto& e = getTextEntry(label, fontSmall_, T().goldLabel);
-        if (e.tex) drawText(label, SCREEN_W - e.w - 15, SCREEN_H - 26, T().goldLabel, fontSmall_);
+        TextExtent e = measureText(label, fontSmall_);
+        if (e.w > 0) drawText(label, SCREEN_W - e.w - 15, SCREEN_H - 26, T().goldLabel, fontSmall_);
     }
 
     // Delete confirmation overlay
@@ -346,9 +347,7 @@ void UI::handleBankSelectorInput(bool& running) {
                     } else {
                         if (!allBanksMode_) {
                             account_.unmountSave();
-                            int cnt = BankManager::countBanks(basePath_, selectedGame_);
-                            gameBankCounts_[selectedGame_] = cnt;
-                            gameBankCounts_[pairedGame(selectedGame_)] = cnt;
+                            recountBanks(selectedGame_);
                         }
                         allBanksMode_ = false;
                         screen_ = AppScreen::GameSelector;
@@ -364,7 +363,14 @@ void UI::handleBankSelectorInput(bool& running) {
                         themeSelCursor_ = themeIndex_;
                         themeSelOriginal_ = themeIndex_;
                     } else if (bankCount > 0) {
-                        beginTextInput(TextInputPurpose::RenameBank);
+                        // Cannot rename a bank that is currently loaded: its
+                        // boxes are still read from the file on demand
+                        const std::string& name = banks[bankSelCursor_].name;
+                        if (name == activeBankName_ || (isDualBankMode() && name == leftBankName_))
+                            showMessageAndWait(i18n::get(StrKey::CannotRename),
+                                               i18n::get(StrKey::BankCurrentlyLoaded));
+                        else
+                            beginTextInput(TextInputPurpose::RenameBank);
                     }
                     break;
                 case SDL_CONTROLLER_BUTTON_BACK: // - = about
@@ -487,6 +493,8 @@ void UI::openSelectedBank() {
     cursor_.panel = bankSelTarget_;
     gameBox_ = 0;
     bankBox_ = 0;
+    if (!isDualBankMode())
+        save_.prefetchBoxesAround(gameBox_);
     showDetail_ = false;
     showMenu_ = false;
     holding_ = false;
@@ -1,6 +1,5 @@
 #include "ui.h"
 #include "i18n.h"
-#include "led.h"
 #include "species_converter.h"
 #include "form_names.h"
 #include "personal_za.h"
@@ -13,6 +12,8 @@
 #include <cmath>
 #include <cctype>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
 #include <sys/stat.h>
 
 // --- Joystick ---
@@ -229,25 +230,13 @@ void UI::handleMenuInput(const SDL_Event& event, bool& running) {
         } else {
             // sel: 0=Switch Bank, 1=Change Game, 2=Save & Quit, 3=Quit Without Saving
             if (sel == 0) {
-                if (!saveBankFiles()) { showMenu_ = false; return; }
-                showWorking(i18n::get(StrKey::Saving));
-                ledBlink();
-                if (save_.isLoaded())
-                    save_.save(savePath_);
-                account_.commitSave();
-                ledOff();
+                if (!saveAllFiles()) { showMenu_ = false; return; }
                 bankManager_.refresh();
                 screen_ = AppScreen::BankSelector;
                 showMenu_ = false;
             } else if (sel == 1) {
                 // Change Game — save everything, unmount, go to game selector
-                if (!saveBankFiles()) { showMenu_ = false; return; }
-                showWorking(i18n::get(StrKey::Saving));
-                ledBlink();
-                if (save_.isLoaded())
-                    save_.save(savePath_);
-                account_.commitSave();
-                ledOff();
+                if (!saveAllFiles()) { showMenu_ = false; return; }
                 account_.unmountSave();
                 activeBankName_.clear();
                 activeBankPath_.clear();
@@ -719,10 +708,14 @@ void UI::switchBox(int direction) {
     if (cursor_.box < 0) cursor_.box = maxBox - 1;
     if (cursor_.box >= maxBox) cursor_.box = 0;
 
-    if (cursor_.panel == Panel::Game)
+    if (cursor_.panel == Panel::Game) {
         gameBox_ = cursor_.box;
-    else
+        // Warm the neighbours so paging on doesn't wait on decryption
+        if (!isDualBankMode())
+            save_.prefetchBoxesAround(gameBox_);
+    } else {
         bankBox_ = cursor_.box;
+    }
 }
 
 Pokemon UI::getPokemonAt(int box, int slot, Panel panel) const {
@@ -749,6 +742,26 @@ void UI::setPokemonAt(int box, int slot, Panel panel, const Pokemon& pkm) {
     invalidateSlotDisplay(panel, box);
 }
 
+void UI::setPokemonBatch(Panel panel, const std::vector<SaveFile::BoxSlotWrite>& writes) {
+    if (panel == Panel::Game) {
+        if (isDualBankMode()) {
+            if (leftBankName_.empty()) return;
+            for (const auto& w : writes)
+                bankLeft_.setSlot(w.box, w.slot, w.pkm);
+        } else
+            save_.setBoxSlots(writes);
+    } else {
+        for (const auto& w : writes)
+            bank_.setSlot(w.box, w.slot, w.pkm);
+    }
+    int lastBox = -1;
+    for (const auto& w : writes) {
+        if (w.box != lastBox)
+            invalidateSlotDisplay(panel, w.box);
+        lastBox = w.box;
+    }
+}
+
 void UI::clearPokemonAt(int box, int slot, Panel panel) {
     if (panel == Panel::Game) {
         if (isDualBankMode()) {
@@ -838,10 +851,12 @@ void UI::actionSelect() {
                     return;
                 }
             }
+            std::vector<SaveFile::BoxSlotWrite> writes;
             for (int i = 0; i < (int)heldMulti_.size(); i++) {
-                setPokemonAt(box, heldMultiSlots_[i], cursor_.panel, heldMulti_[i]);
+                writes.push_back({box, heldMultiSlots_[i], heldMulti_[i]});
                 updatePartyPtr(heldMultiSlots_[i], box, heldMultiSlots_[i]);
             }
+            setPokemonBatch(cursor_.panel, writes);
         } else {
             // First-available: fill empty slots in order
             int slotsInBox = maxSlots();
@@ -855,14 +870,16 @@ void UI::actionSelect() {
                     i18n::fmt(StrKey::NeedEmptySlots, std::to_string(heldMulti_.size()), std::to_string(emptyCount)));
                 return;
             }
+            std::vector<SaveFile::BoxSlotWrite> writes;
             int placed = 0;
             for (int s = 0; s < slotsInBox && placed < (int)heldMulti_.size(); s++) {
                 if (getPokemonAt(box, s, cursor_.panel).isEmpty()) {
-                    setPokemonAt(box, s, cursor_.panel, heldMulti_[placed]);
+                    writes.push_back({box, s, heldMulti_[placed]});
                     updatePartyPtr(heldMultiSlots_[placed], box, s);
                     placed++;
                 }
             }
+            setPokemonBatch(cursor_.panel, writes);
         }
         heldMulti_.clear();
         heldMultiSlots_.clear();
@@ -949,8 +966,10 @@ void UI::actionCancel() {
 
     // Multi-hold cancel: return all to original positions
     if (holding_ && !heldMulti_.empty()) {
+        std::vector<SaveFile::BoxSlotWrite> writes;
         for (int i = 0; i < (int)heldMulti_.size(); i++)
-            setPokemonAt(heldMultiBox_, heldMultiSlots_[i], heldMultiSource_, heldMulti_[i]);
+            writes.push_back({heldMultiBox_, heldMultiSlots_[i], heldMulti_[i]});
+        setPokemonBatch(heldMultiSource_, writes);
         heldMulti_.clear();
         heldMultiSlots_.clear();
         holding_ = false;
@@ -1411,7 +1430,10 @@ void UI::handleSearchResultsInput(const SDL_Event& event) {
 
     auto jumpToResult = [&]() {
         if (searchResults_.empty()) return;
-        const auto& r = searchResults_[searchResultCursor_];
+        const auto r = searchResults_[searchResultCursor_];
+        stopDiskSearch();
+        if (!r.bankPath.empty() && !openResultBank(r))
+            return;
         cursor_.panel = r.panel;
         cursor_.box = r.box;
         cursor_.col = r.slot % gridCols();
@@ -1443,9 +1465,11 @@ void UI::handleSearchResultsInput(const SDL_Event& event) {
                 jumpToResult();
                 break;
             case SDL_CONTROLLER_BUTTON_A: // Switch B = close
+                stopDiskSearch();
                 showSearchResults_ = false;
                 break;
             case SDL_CONTROLLER_BUTTON_Y: // Switch X = back to filter
+                stopDiskSearch();
                 showSearchResults_ = false;
                 showSearchFilter_ = true;
                 break;
@@ -1459,130 +1483,198 @@ void UI::handleSearchResultsInput(const SDL_Event& event) {
     }
 }
 
-bool UI::matchesSearchFilter(const Pokemon& pkm,
-                             const std::string& filterSpecies,
-                             const std::string& filterOT) const {
-    if (pkm.isEmpty()) return false;
-
+SearchQuery UI::buildSearchQuery() const {
     auto toLower = [](const std::string& s) {
         std::string out = s;
         for (auto& c : out) c = std::tolower(static_cast<unsigned char>(c));
         return out;
     };
 
-    // Species filter: exact match by ID if set, otherwise substring match
-    if (searchFilter_.speciesId > 0) {
-        if (pkm.species() != searchFilter_.speciesId)
-            return false;
-    } else if (!filterSpecies.empty()) {
-        std::string name = toLower(SpeciesName::get(pkm.species()));
-        if (name.find(filterSpecies) == std::string::npos)
-            return false;
-    }
-
-    if (!filterOT.empty()) {
-        std::string ot = toLower(pkm.otName());
-        if (ot.find(filterOT) == std::string::npos)
-            return false;
-    }
-
-    if (searchFilter_.filterShiny && !pkm.isShiny()) return false;
-    if (searchFilter_.filterEgg && !pkm.isEgg()) return false;
-    if (searchFilter_.filterAlpha && !pkm.isAlpha()) return false;
-
-    if (searchFilter_.gender != GenderFilter::Any) {
-        uint8_t g = pkm.gender();
-        if (searchFilter_.gender == GenderFilter::Male && g != 0) return false;
-        if (searchFilter_.gender == GenderFilter::Female && g != 1) return false;
-        if (searchFilter_.gender == GenderFilter::Genderless && g != 2) return false;
-    }
-
-    if (!pkm.isEgg()) {
-        uint8_t lv = pkm.level();
-        if (searchFilter_.levelMin > 0 && lv < searchFilter_.levelMin) return false;
-        if (searchFilter_.levelMax > 0 && lv > searchFilter_.levelMax) return false;
-    }
-
-    if (searchFilter_.perfectIVs != PerfectIVFilter::Off) {
-        int perfect = 0;
-        if (pkm.ivHp()  == 31) perfect++;
-        if (pkm.ivAtk() == 31) perfect++;
-        if (pkm.ivDef() == 31) perfect++;
-        if (pkm.ivSpe() == 31) perfect++;
-        if (pkm.ivSpA() == 31) perfect++;
-        if (pkm.ivSpD() == 31) perfect++;
-        if (searchFilter_.perfectIVs == PerfectIVFilter::AtLeastOne && perfect == 0) return false;
-        if (searchFilter_.perfectIVs == PerfectIVFilter::All6 && perfect < 6) return false;
-    }
-
-    if (searchFilter_.ribbonFilter != RibbonFilter::Off) {
-        auto ribbons = pkm.getRibbonsAndMarks();
-        if (searchFilter_.ribbonFilter == RibbonFilter::HasAny) {
-            if (ribbons.empty()) return false;
-        } else if (searchFilter_.ribbonFilter == RibbonFilter::HasRibbon) {
-            bool found = false;
-            for (const auto& r : ribbons) { if (!r.isMark) { found = true; break; } }
-            if (!found) return false;
-        } else if (searchFilter_.ribbonFilter == RibbonFilter::HasMark) {
-            bool found = false;
-            for (const auto& r : ribbons) { if (r.isMark) { found = true; break; } }
-            if (!found) return false;
-        }
-    }
-
-    return true;
+    SearchQuery q;
+    q.speciesId   = searchFilter_.speciesId;
+    q.speciesName = toLower(searchFilter_.speciesName);
+    q.otName      = toLower(searchFilter_.otName);
+    q.shiny = searchFilter_.filterShiny;
+    q.egg   = searchFilter_.filterEgg;
+    q.alpha = searchFilter_.filterAlpha;
+    switch (searchFilter_.gender) {
+        case GenderFilter::Any:        q.gender = -1; break;
+        case GenderFilter::Male:       q.gender = 0;  break;
+        case GenderFilter::Female:     q.gender = 1;  break;
+        case GenderFilter::Genderless: q.gender = 2;  break;
+    }
+    q.levelMin = searchFilter_.levelMin;
+    q.levelMax = searchFilter_.levelMax;
+    if (searchFilter_.perfectIVs == PerfectIVFilter::AtLeastOne) q.minPerfectIVs = 1;
+    if (searchFilter_.perfectIVs == PerfectIVFilter::All6)       q.minPerfectIVs = 6;
+    q.hasRibbon = searchFilter_.ribbonFilter == RibbonFilter::HasRibbon;
+    q.hasMark   = searchFilter_.ribbonFilter == RibbonFilter::HasMark;
+    q.hasAny    = searchFilter_.ribbonFilter == RibbonFilter::HasAny;
+    return q;
 }
 
-void UI::executeSearch() {
-    searchResults_.clear();
-
-    auto toLower = [](const std::string& s) {
-        std::string out = s;
-        for (auto& c : out) c = std::tolower(static_cast<unsigned char>(c));
-        return out;
-    };
-    std::string filterSpecies = toLower(searchFilter_.speciesName);
-    std::string filterOT = toLower(searchFilter_.otName);
+void UI::scanSearchResults() {
+    SearchQuery query = buildSearchQuery();
+    std::vector<int> hits;
 
     auto scanPanel = [&](Panel panel) {
-        int boxes, slots;
+        const SearchIndex* index;
+        int slots;
         if (panel == Panel::Game) {
             if (isDualBankMode()) {
                 if (leftBankName_.empty()) return;
-                boxes = bankLeft_.boxCount();
+                index = &bankLeft_.searchIndex();
                 slots = bankLeft_.slotsPerBox();
             } else {
-                boxes = save_.boxCount();
+                index = &save_.searchIndex();
                 slots = save_.slotsPerBox();
             }
         } else {
-            boxes = bank_.boxCount();
+            index = &bank_.searchIndex();
             slots = bank_.slotsPerBox();
         }
 
-        for (int b = 0; b < boxes; b++) {
-            for (int s = 0; s < slots; s++) {
-                Pokemon pkm = getPokemonAt(b, s, panel);
-                if (matchesSearchFilter(pkm, filterSpecies, filterOT)) {
-                    SearchResult r;
-                    r.panel = panel;
-                    r.box = b;
-                    r.slot = s;
-                    r.speciesName = SpeciesName::get(pkm.species());
-                    r.level = pkm.level();
-                    r.isShiny = pkm.isShiny();
-                    r.isEgg = pkm.isEgg();
-                    r.isAlpha = pkm.isAlpha();
-                    r.gender = pkm.gender();
-                    r.otName = pkm.otName();
-                    searchResults_.push_back(r);
-                }
-            }
+        hits.clear();
+        index->scan(query, hits);
+        for (int i : hits) {
+            SearchResult r;
+            r.panel = panel;
+            r.box = i / slots;
+            r.slot = i % slots;
+            r.speciesName = SpeciesName::get(index->species(i));
+            r.level = index->level(i);
+            r.isShiny = index->isShiny(i);
+            r.isEgg = index->isEgg(i);
+            r.isAlpha = index->isAlpha(i);
+            r.gender = index->gender(i);
+            r.otName = index->otName(i);
+            searchResults_.push_back(r);
         }
     };
 
     scanPanel(Panel::Game);
     scanPanel(Panel::Bank);
+}
+
+void UI::scanDiskBanks() {
+    stopDiskSearch();
+    {
+        std::lock_guard<std::mutex> lock(diskSearchMutex_);
+        diskSearchResults_.clear();
+    }
+    diskSearchCancel_.store(false, std::memory_order_relaxed);
+    diskSearchDone_.store(0, std::memory_order_relaxed);
+    diskSearchTotal_.store(0, std::memory_order_relaxed);
+    diskSearchSeen_ = 0;
+    diskSearchRunning_.store(true, std::memory_order_release);
+
+    // Open banks were already scanned from memory
+    diskSearchWorker_ = std::thread([this, query = buildSearchQuery(), basePath = basePath_,
+                                     skipA = activeBankPath_, skipB = leftBankPath_] {
+        std::vector<BankInfo> banks;
+        for (auto& info : BankManager::scanAll(basePath))
+            if (info.fullPath != skipA && info.fullPath != skipB)
+                banks.push_back(std::move(info));
+        diskSearchTotal_.store(static_cast<int>(banks.size()), std::memory_order_relaxed);
+
+        std::vector<int> hits;
+        SearchIndex index;
+        for (const auto& info : banks) {
+            if (diskSearchCancel_.load(std::memory_order_relaxed))
+                break;
+            if (BankManager::loadSearchIndex(info, index)) {
+                hits.clear();
+                index.scan(query, hits);
+                int slots = gameInfo(info.game).slotsPerBox;
+                std::vector<SearchResult> found;
+                for (int i : hits) {
+                    SearchResult r;
+                    r.panel = Panel::Bank;
+                    r.box = i / slots;
+                    r.slot = i % slots;
+                    r.speciesName = SpeciesName::get(index.species(i));
+                    r.level = index.level(i);
+                    r.isShiny = index.isShiny(i);
+                    r.isEgg = index.isEgg(i);
+                    r.isAlpha = index.isAlpha(i);
+                    r.gender = index.gender(i);
+                    r.otName = index.otName(i);
+                    r.bankName = info.name;
+                    r.bankPath = info.fullPath;
+                    r.bankGame = info.game;
+                    found.push_back(std::move(r));
+                }
+                std::lock_guard<std::mutex> lock(diskSearchMutex_);
+                diskSearchResults_.insert(diskSearchResults_.end(),
+                                          std::make_move_iterator(found.begin()),
+                                          std::make_move_iterator(found.end()));
+            }
+            diskSearchDone_.fetch_add(1, std::memory_order_relaxed);
+        }
+        diskSearchRunning_.store(false, std::memory_order_release);
+    });
+}
+
+void UI::stopDiskSearch() {
+    if (!diskSearchWorker_.joinable())
+        return;
+    diskSearchCancel_.store(true, std::memory_order_relaxed);
+    diskSearchWorker_.join();
+    diskSearchRunning_.store(false, std::memory_order_relaxed);
+}
+
+bool UI::collectDiskSearch() {
+    if (!diskSearchWorker_.joinable())
+        return false;
+    bool finished = !diskSearchRunning_.load(std::memory_order_acquire);
+    std::vector<SearchResult> results;
+    {
+        std::lock_guard<std::mutex> lock(diskSearchMutex_);
+        results.swap(diskSearchResults_);
+    }
+    // Appending keeps the cursor on the row it was on
+    searchResults_.insert(searchResults_.end(),
+                          std::make_move_iterator(results.begin()),
+                          std::make_move_iterator(results.end()));
+    if (finished)
+        diskSearchWorker_.join();
+
+    int done = diskSearchDone_.load(std::memory_order_relaxed);
+    bool progressed = done != diskSearchSeen_;
+    diskSearchSeen_ = done;
+    return finished || progressed || !results.empty();
+}
+
+bool UI::openResultBank(const SearchResult& r) {
+    if (!saveBankFiles())
+        return false;
+    showWorking(i18n::get(StrKey::LoadingBank));
+
+    if (std::strcmp(bankFolderNameOf(r.bankGame), bankFolderNameOf(selectedGame_)) != 0) {
+        // Different game family: the left bank can't stay open beside it
+        leftBankName_.clear();
+        leftBankPath_.clear();
+        selectedGame_ = r.bankGame;
+        save_.setGameType(selectedGame_);
+        bankLeft_.setGameType(selectedGame_);
+        bankManager_.init(basePath_, selectedGame_);
+    }
+
+    bank_.load(r.bankPath);
+    bank_.setGameType(selectedGame_);
+    activeBankPath_ = r.bankPath;
+    activeBankName_ = r.bankName;
+    invalidateAllSlotDisplays();
+    return true;
+}
+
+void UI::executeSearch() {
+    stopDiskSearch();
+    searchResults_.clear();
+    scanSearchResults();
+    // All-banks mode: the result list also covers banks that aren't open
+    if (allBanksMode_ && searchFilter_.mode == SearchMode::List)
+        scanDiskBanks();
 
     if (searchFilter_.mode == SearchMode::Highlight) {
         searchMatchSet_.clear();
@@ -1672,49 +1764,14 @@ void UI::refreshHighlightSet() {
     if (!searchHighlightActive_) return;
     searchMatchSet_.clear();
     searchResults_.clear();
+    scanSearchResults();
 
-    auto toLower = [](const std::string& s) {
-        std::string out = s;
-        for (auto& c : out) c = std::tolower(static_cast<unsigned char>(c));
-        return out;
-    };
-    std::string filterSpecies = toLower(searchFilter_.speciesName);
-    std::string filterOT = toLower(searchFilter_.otName);
-
-    auto scanPanel = [&](Panel panel) {
-        int boxes, slots;
-        if (panel == Panel::Game) {
-            if (isDualBankMode()) {
-                if (leftBankName_.empty()) return;
-                boxes = bankLeft_.boxCount();
-                slots = bankLeft_.slotsPerBox();
-            } else {
-                boxes = save_.boxCount();
-                slots = save_.slotsPerBox();
-            }
-        } else {
-            boxes = bank_.boxCount();
-            slots = bank_.slotsPerBox();
-        }
-
-        for (int b = 0; b < boxes; b++) {
-            for (int s = 0; s < slots; s++) {
-                Pokemon pkm = getPokemonAt(b, s, panel);
-                if (matchesSearchFilter(pkm, filterSpecies, filterOT)) {
-                    uint64_t key = (static_cast<uint64_t>(panel == Panel::Bank ? 1 : 0) << 48)
-                                 | (static_cast<uint64_t>(b) << 16)
-                                 | static_cast<uint64_t>(s);
-                    searchMatchSet_.insert(key);
-                    searchResults_.push_back({panel, b, s, SpeciesName::get(pkm.species()),
-                        pkm.level(), pkm.isShiny(), pkm.isEgg(), pkm.isAlpha(),
-                        pkm.gender(), pkm.otName()});
-                }
-            }
-        }
-    };
-
-    scanPanel(Panel::Game);
-    scanPanel(Panel::Bank);
+    for (const auto& r : searchResults_) {
+        uint64_t key = (static_cast<uint64_t>(r.panel == Panel::Bank ? 1 : 0) << 48)
+                     | (static_cast<uint64_t>(r.box) << 16)
+                     | static_cast<uint64_t>(r.slot);
+        searchMatchSet_.insert(key);
+    }
 }
 
 // --- Wondercard List ---
@@ -1945,52 +2002,7 @@ std::string UI::exportPokemon(const Pokemon& pkm) {
     std::string dir = basePath_ + "export/";
     std::string gameDir = dir + bankFolderNameOf(selectedGame_) + "/";
 
-    // PKHeX naming: {species:0000} - {form} - {flags} - {name} - {checksum:X4}{EC:X8}.{ext}
-    char buf[512];
-    uint16_t sp = pkm.species();
-    uint8_t fm = pkm.form();
-    const char* ext = pkFileExtension(selectedGame_);
-
-    std::string formStr;
-    if (fm != 0) {
-        const char* formName = getFormName(sp, fm);
-        if (formName)
-            formStr = std::string(" - ") + formName;
-        else {
-            char fb[16];
-            std::snprintf(fb, sizeof(fb), " - %02u", fm);
-            formStr = fb;
-        }
-    }
-
-    std::string tags;
-    {
-        std::string flags;
-        if (pkm.isShiny()) flags += "S";
-        if (pkm.isAlpha()) flags += "A";
-        if (pkm.isEgg())   flags += "E";
-        if (!flags.empty()) tags = " - [" + flags + "]";
-    }
-    std::string nick = SpeciesName::get(sp);
-
-    // Checksum at 0x06 for modern, 0x1C for PK3
-    uint16_t chk = isFRLG(selectedGame_) ? pkm.readU16(0x1C) : pkm.readU16(0x06);
-    uint32_t ec = pkm.encryptionConstant();
-
-    // Short game tag
-    const char* gameTag = gameInfo(selectedGame_).gameTag;
-
-    std::snprintf(buf, sizeof(buf), "%s - %04u%s%s - %s - %04X%08X.%s",
-                  gameTag, sp, formStr.c_str(), tags.c_str(), nick.c_str(), chk, ec, ext);
-
-    // Sanitize filename: replace filesystem-unsafe chars
-    std::string filename = buf;
-    for (char& c : filename) {
-        if (c == '/' || c == '\\' || c == ':' || c == '*' ||
-            c == '?' || c == '"' || c == '<' || c == '>' || c == '|')
-            c = '_';
-    }
-
+    std::string filename = pkm.exportFileName(selectedGame_);
     std::string fullPath = gameDir + filename;
 
     // Create directories only when we're about to write
@@ -14,6 +14,7 @@ static uint32_t spriteKey(uint16_t id, uint8_t form) {
 
 static SDL_Texture* loadSprite(const char* dir, uint16_t nationalId, uint8_t form,
                                SDL_Renderer* renderer) {
+    Profiler::Scope probe(ProfZone::SpriteLoad);
     char filename[64];
     // Try form-specific sprite first (e.g. 019-1.png)
     if (form != 0) {
@@ -39,54 +40,50 @@ static SDL_Texture* loadSprite(const char* dir, uint16_t nationalId, uint8_t for
     return tex;
 }
 
-SDL_Texture* UI::getSprite(uint16_t nationalId, uint8_t form) {
-    uint32_t key = spriteKey(nationalId, form);
-    auto it = spriteCache_.find(key);
-    if (it != spriteCache_.end())
-        return it->second;
+static SDL_Texture* loadTexture(SDL_Renderer* renderer, const std::string& path) {
+    Profiler::Scope probe(ProfZone::SpriteLoad);
+    return IMG_LoadTexture(renderer, path.c_str());
+}
 
-    SDL_Texture* tex = loadSprite("sprites", nationalId, form, renderer_);
-    spriteCache_[key] = tex;
-    return tex;
+// Whole-texture SpriteRef for a sprite loaded from its own PNG
+static SpriteRef looseSprite(SDL_Texture* tex) {
+    SpriteRef ref;
+    ref.tex = tex;
+    if (tex)
+        SDL_QueryTexture(tex, nullptr, nullptr, &ref.src.w, &ref.src.h);
+    return ref;
 }
 
-SDL_Texture* UI::getShinySprite(uint16_t nationalId, uint8_t form) {
-    uint32_t key = spriteKey(nationalId, form);
-    auto it = shinySpriteCache_.find(key);
-    if (it != shinySpriteCache_.end())
-        return it->second;
+SpriteRef UI::getSprite(uint16_t nationalId, uint8_t form) {
+    if (SpriteRef ref = spriteAtlas_.find(nationalId, form))
+        return ref;
 
-    SDL_Texture* tex = loadSprite("sprites_shiny", nationalId, form, renderer_);
-    shinySpriteCache_[key] = tex;
-    return tex;
+    // No atlas (or sprite missing from it): fall back to the loose PNG
+    std::string key = "sprite/" + std::to_string(spriteKey(nationalId, form));
+    return looseSprite(textureCache_.get(key, [&] {
+        return loadSprite("sprites", nationalId, form, renderer_);
+    }));
+}
+
+SpriteRef UI::getShinySprite(uint16_t nationalId, uint8_t form) {
+    if (SpriteRef ref = shinySpriteAtlas_.find(nationalId, form))
+        return ref;
+
+    std::string key = "shiny/" + std::to_string(spriteKey(nationalId, form));
+    return looseSprite(textureCache_.get(key, [&] {
+        return loadSprite("sprites_shiny", nationalId, form, renderer_);
+    }));
+}
+
+void UI::loadSpriteAtlases() {
+    spriteAtlas_.load("romfs:/atlas/sprites.atlas", renderer_);
+    shinySpriteAtlas_.load("romfs:/atlas/sprites_shiny.atlas", renderer_);
 }
 
 void UI::freeSprites() {
-    for (auto& [id, tex] : spriteCache_) {
-        if (tex)
-            SDL_DestroyTexture(tex);
-    }
-    spriteCache_.clear();
-    for (auto& [id, tex] : shinySpriteCache_) {
-        if (tex)
-            SDL_DestroyTexture(tex);
-    }
-    shinySpriteCache_.clear();
-    for (auto& [name, tex] : ribbonSpriteCache_) {
-        if (tex)
-            SDL_DestroyTexture(tex);
-    }
-    ribbonSpriteCache_.clear();
-    for (auto& [id, tex] : ballSpriteCache_) {
-        if (tex)
-            SDL_DestroyTexture(tex);
-    }
-    ballSpriteCache_.clear();
-    for (auto& [id, tex] : typeSpriteCache_) {
-        if (tex)
-            SDL_DestroyTexture(tex);
-    }
-    typeSpriteCache_.clear();
+    spriteAtlas_.free();
+    shinySpriteAtlas_.free();
+    textureCache_.clear();
     if (iconShiny_)      { SDL_DestroyTexture(iconShiny_);      iconShiny_ = nullptr; }
     if (iconAlpha_)      { SDL_DestroyTexture(iconAlpha_);      iconAlpha_ = nullptr; }
     if (iconShinyAlpha_) { SDL_DestroyTexture(iconShinyAlpha_); iconShinyAlpha_ = nullptr; }
@@ -96,41 +93,26 @@ void UI::freeSprites() {
 }
 
 SDL_Texture* UI::getRibbonSprite(const std::string& filename) {
-    auto it = ribbonSpriteCache_.find(filename);
-    if (it != ribbonSpriteCache_.end())
-        return it->second;
-
-    std::string path;
-    path = "romfs:/ribbons/" + filename + ".png";
-    SDL_Texture* tex = IMG_LoadTexture(renderer_, path.c_str());
-    ribbonSpriteCache_[filename] = tex; // cache even if null
-    return tex;
+    return textureCache_.get("ribbon/" + filename, [&] {
+        std::string path = "romfs:/ribbons/" + filename + ".png";
+        return loadTexture(renderer_, path);
+    });
 }
 
 SDL_Texture* UI::getBallSprite(uint8_t ballId) {
-    auto it = ballSpriteCache_.find(ballId);
-    if (it != ballSpriteCache_.end())
-        return it->second;
-
-    std::string path;
-    path = "romfs:/balls/_ball" + std::to_string(ballId) + ".png";
-    SDL_Texture* tex = IMG_LoadTexture(renderer_, path.c_str());
-    ballSpriteCache_[ballId] = tex;
-    return tex;
+    return textureCache_.get("ball/" + std::to_string(ballId), [&] {
+        std::string path = "romfs:/balls/_ball" + std::to_string(ballId) + ".png";
+        return loadTexture(renderer_, path);
+    });
 }
 
 SDL_Texture* UI::getTypeSprite(uint8_t typeId) {
-    auto it = typeSpriteCache_.find(typeId);
-    if (it != typeSpriteCache_.end())
-        return it->second;
-
-    char filename[32];
-    std::snprintf(filename, sizeof(filename), "type_icon_s_%02d.png", typeId);
-    std::string path;
-    path = std::string("romfs:/types/") + filename;
-    SDL_Texture* tex = IMG_LoadTexture(renderer_, path.c_str());
-    typeSpriteCache_[typeId] = tex;
-    return tex;
+    return textureCache_.get("type/" + std::to_string(typeId), [&] {
+        char filename[32];
+        std::snprintf(filename, sizeof(filename), "type_icon_s_%02d.png", typeId);
+        std::string path = std::string("romfs:/types/") + filename;
+        return loadTexture(renderer_, path);
+    });
 }
 
 // --- Rendering ---
@@ -149,53 +131,22 @@ void UI::drawRectOutline(int x, int y, int w, int h, SDL_Color color, int thickn
     }
 }
 
-static uint32_t packColor(SDL_Color c) {
-    return (uint32_t(c.r) << 24) | (uint32_t(c.g) << 16) | (uint32_t(c.b) << 8) | c.a;
-}
-
-const UI::TextCacheEntry& UI::getTextEntry(const std::string& text, TTF_Font* f, SDL_Color color) {
-    TextCacheKey key{text, f, packColor(color)};
-    auto it = textCache_.find(key);
-    if (it != textCache_.end())
-        return it->second;
-
-    // Cap cache size to limit GPU memory on Switch
-    if (textCache_.size() >= 512)
-        clearTextCache();
-
-    SDL_Surface* surf = TTF_RenderUTF8_Blended(f, text.c_str(), color);
-    TextCacheEntry entry{};
-    if (surf) {
-        entry.tex = SDL_CreateTextureFromSurface(renderer_, surf);
-        entry.w = surf->w;
-        entry.h = surf->h;
-        SDL_FreeSurface(surf);
-    }
-    return textCache_.emplace(std::move(key), entry).first->second;
-}
-
-void UI::clearTextCache() {
-    for (auto& [k, e] : textCache_) {
-        if (e.tex)
-            SDL_DestroyTexture(e.tex);
-    }
-    textCache_.clear();
+TextExtent UI::measureText(const std::string& text, GlyphFont* f) const {
+    if (!f || text.empty()) return {};
+    return f->measure(text);
 }
 
-void UI::drawText(const std::string& text, int x, int y, SDL_Color color, TTF_Font* f) {
+void UI::drawText(const std::string& text, int x, int y, SDL_Color color, GlyphFont* f) {
     if (!f || text.empty()) return;
-    const auto& entry = getTextEntry(text, f, color);
-    if (!entry.tex) return;
-    SDL_Rect dst = {x, y, entry.w, entry.h};
-    SDL_RenderCopy(renderer_, entry.tex, nullptr, &dst);
+    Profiler::Scope probe(ProfZone::Text);
+    f->draw(text, x, y, color);
 }
 
-void UI::drawTextCentered(const std::string& text, int cx, int cy, SDL_Color color, TTF_Font* f) {
+void UI::drawTextCentered(const std::string& text, int cx, int cy, SDL_Color color, GlyphFont* f) {
     if (!f || text.empty()) return;
-    const auto& entry = getTextEntry(text, f, color);
-    if (!entry.tex) return;
-    SDL_Rect dst = {cx - entry.w/2, cy - entry.h/2, entry.w, entry.h};
-    SDL_RenderCopy(renderer_, entry.tex, nullptr, &dst);
+    Profiler::Scope probe(ProfZone::Text);
+    TextExtent e = f->measure(text);
+    f->draw(text, cx - e.w/2, cy - e.h/2, color);
 }
 
 void UI::drawStatusBar(const std::string& msg) {
@@ -209,6 +160,7 @@ const std::vector<UI::SlotDisplay>& UI::getSlotDisplays(Panel panel, int box) {
     if (it != slotDisplayCache_.end())
         return it->second;
 
+    Profiler::Scope probe(ProfZone::SlotDisplays);
     // Cap cache size
     if (slotDisplayCache_.size() >= 8)
         slotDisplayCache_.clear();
@@ -275,7 +227,7 @@ void UI::drawSlot(int x, int y, const SlotDisplay& sd, bool isCursor, int select
 
     if (!sd.empty) {
         // Draw sprite centered in top portion of cell (form-aware, shiny variant if available)
-        SDL_Texture* sprite = nullptr;
+        SpriteRef sprite;
         if (sd.egg) {
             sprite = getSprite(0);
         } else if (sd.shiny) {
@@ -286,8 +238,7 @@ void UI::drawSlot(int x, int y, const SlotDisplay& sd, bool isCursor, int select
         }
 
         if (sprite) {
-            int texW, texH;
-            SDL_QueryTexture(sprite, nullptr, nullptr, &texW, &texH);
+            int texW = sprite.src.w, texH = sprite.src.h;
 
             int dstW, dstH;
             if (texW > 0 && texH > 0) {
@@ -303,7 +254,7 @@ void UI::drawSlot(int x, int y, const SlotDisplay& sd, bool isCursor, int select
             int sprX = x + (CELL_W - dstW) / 2;
             int sprY = y + 4 + (SPRITE_SIZE - dstH) / 2;
             SDL_Rect dst = {sprX, sprY, dstW, dstH};
-            SDL_RenderCopy(renderer_, sprite, nullptr, &dst);
+            SDL_RenderCopy(renderer_, sprite.tex, &sprite.src, &dst);
         }
 
         // Species name below sprite
@@ -340,7 +291,7 @@ void UI::drawSlot(int x, int y, const SlotDisplay& sd, bool isCursor, int select
     // Numbered badge on top of everything
     if (selectOrder > 0) {
         std::string num = std::to_string(selectOrder);
-        auto& numEntry = getTextEntry(num, font_, positionPreserve_ ? T().selectedPos : T().selected);
+        TextExtent numEntry = measureText(num, font_);
         int tw = numEntry.w, th = numEntry.h;
         int badgeR = std::max(tw, th) / 2 + 6;
         int cx = x + CELL_W / 2;
@@ -372,11 +323,11 @@ void UI::drawPanel(int panelX, const std::string& boxName, int boxIdx,
     std::string hdrText = boxName + " (" + std::to_string(boxIdx + 1) + "/" + std::to_string(totalBoxes) + ")";
     // Truncate if too wide for panel (leave room for arrows)
     int maxHdrW = PANEL_W - 80;
-    int tw = getTextEntry(hdrText, font_, hdrColor).w;
+    int tw = measureText(hdrText, font_).w;
     if (tw > maxHdrW) {
         while (hdrText.size() > 5 && tw > maxHdrW) {
             hdrText = hdrText.substr(0, hdrText.size() - 5) + "(..)";
-            tw = getTextEntry(hdrText, font_, hdrColor).w;
+            tw = measureText(hdrText, font_).w;
         }
     }
     drawTextCentered(hdrText, panelX + PANEL_W / 2, BOX_HDR_Y + BOX_HDR_H / 2, hdrColor, font_);
@@ -418,6 +369,8 @@ void UI::drawPanel(int panelX, const std::string& boxName, int boxIdx,
 }
 
 void UI::drawFrame() {
+    Profiler::Scope probe(ProfZone::Draw);
+
     // Clear screen
     SDL_SetRenderDrawColor(renderer_, T().bg.r, T().bg.g, T().bg.b, 255);
     SDL_RenderClear(renderer_);
@@ -498,8 +451,8 @@ void UI::drawFrame() {
         else if (selectedProfile_ >= 0 && selectedProfile_ < account_.profileCount())
             label = account_.profiles()[selectedProfile_].nickname + " | ";
         label += gameDisplayNameOf(selectedGame_);
-        const auto& entry = getTextEntry(label, fontSmall_, T().goldLabel);
-        if (entry.tex)
+        TextExtent entry = measureText(label, fontSmall_);
+        if (entry.w > 0)
             drawText(label, SCREEN_W - entry.w - 15, SCREEN_H - 26, T().goldLabel, fontSmall_);
     }
 
@@ -668,9 +621,9 @@ void UI::drawRadarChart(int cx, int cy, int radius, const int values[6], int max
                            : (values[i] == 0)      ? T().textDim
                            :                          T().text;
 
-        auto& ne = getTextEntry(name, fontSmall_, nameColor);
+        TextExtent ne = measureText(name, fontSmall_);
         int nw = ne.w, nh = ne.h;
-        auto& ve = getTextEntry(valStr, fontSmall_, valColor);
+        TextExtent ve = measureText(valStr, fontSmall_);
         int vw = ve.w, vh = ve.h;
 
         if (i == 0) { // Top: centered, name then value downward
@@ -707,7 +660,7 @@ void UI::drawDetailPopup(const Pokemon& pkm) {
     int sprX = popX + 20;
     int sprY = popY + 20;
 
-    SDL_Texture* sprite = nullptr;
+    SpriteRef sprite;
     uint8_t pkmForm = pkm.form();
     if (pkm.isEgg()) {
         sprite = getSprite(0);
@@ -718,8 +671,7 @@ void UI::drawDetailPopup(const Pokemon& pkm) {
         sprite = getSprite(pkm.species(), pkmForm);
     }
     if (sprite) {
-        int texW, texH;
-        SDL_QueryTexture(sprite, nullptr, nullptr, &texW, &texH);
+        int texW = sprite.src.w, texH = sprite.src.h;
         int dstW, dstH;
         if (texW > 0 && texH > 0) {
             float scale = std::min(static_cast<float>(LARGE_SPRITE) / texW,
@@ -733,7 +685,7 @@ void UI::drawDetailPopup(const Pokemon& pkm) {
         int dx = sprX + (LARGE_SPRITE - dstW) / 2;
         int dy = sprY + (LARGE_SPRITE - dstH) / 2;
         SDL_Rect dst = {dx, dy, dstW, dstH};
-        SDL_RenderCopy(renderer_, sprite, nullptr, &dst);
+        SDL_RenderCopy(renderer_, sprite.tex, &sprite.src, &dst);
     }
 
     // Shiny/Alpha icon next to sprite
@@ -760,7 +712,7 @@ void UI::drawDetailPopup(const Pokemon& pkm) {
     if (ballId > 0) {
         SDL_Texture* ballTex = getBallSprite(ballId);
         if (ballTex) {
-            int textH = TTF_FontHeight(font_);
+            int textH = font_->height();
             int by = infoY + (textH - BALL_SZ) / 2;
             SDL_Rect ballDst = {infoX, by, BALL_SZ, BALL_SZ};
             SDL_RenderCopy(renderer_, ballTex, nullptr, &ballDst);
@@ -772,13 +724,13 @@ void UI::drawDetailPopup(const Pokemon& pkm) {
     drawText(specName, nameStartX, infoY, nameColor, font_);
 
     std::string lvlStr = "  " + i18n::get(StrKey::LvPrefix) + std::to_string(pkm.level());
-    int nameW = getTextEntry(specName, font_, nameColor).w;
+    int nameW = measureText(specName, font_).w;
     drawText(lvlStr, nameStartX + nameW, infoY, T().text, font_);
 
     // Gender symbol
     uint8_t g = pkm.gender();
     int afterLvl = nameStartX + nameW;
-    int lvlW = getTextEntry(lvlStr, font_, T().text).w;
+    int lvlW = measureText(lvlStr, font_).w;
     afterLvl += lvlW + 4;
     if (g == 0)
         drawText("\xe2\x99\x82", afterLvl, infoY, T().genderMale, font_);
@@ -824,7 +776,7 @@ void UI::drawDetailPopup(const Pokemon& pkm) {
     constexpr int TYPE_ICON_H = 25;
     constexpr int MOVE_ROW_H = 28;
     constexpr int MOVE_COL_W = 230;
-    int textH = TTF_FontHeight(font_);
+    int textH = font_->height();
     uint16_t moves[4] = {pkm.move1(), pkm.move2(), pkm.move3(), pkm.move4()};
     for (int i = 0; i < 4; i++) {
         int col = i % 2;
@@ -874,7 +826,7 @@ void UI::drawDetailPopup(const Pokemon& pkm) {
             }
 
             // Center both icon and text vertically within the row
-            int textH = TTF_FontHeight(font_);
+            int textH = font_->height();
             int contentH = std::max(ICON_SZ, textH);
             int baseY = ribbonY + (RIB_ROW_H - contentH) / 2;
             int iconY = baseY + (contentH - ICON_SZ) / 2;
@@ -1102,11 +1054,11 @@ void UI::drawSearchFilterPopup() {
             case 0: {
                 drawText(i18n::get(StrKey::FilterSpecies), labelX, textY, T().text, font_);
                 if (searchFilter_.speciesId > 0) {
-                    SDL_Texture* spr = getSprite(searchFilter_.speciesId);
+                    SpriteRef spr = getSprite(searchFilter_.speciesId);
                     if (spr) {
                         int sprSize = ROW_H - 6;
                         SDL_Rect dst = { valueX, rowY + 2, sprSize, sprSize };
-                        SDL_RenderCopy(renderer_, spr, nullptr, &dst);
+                        SDL_RenderCopy(renderer_, spr.tex, &spr.src, &dst);
                         drawText(searchFilter_.speciesName, valueX + sprSize + 6, textY, T().text, font_);
                     } else {
                         drawText(searchFilter_.speciesName, valueX, textY, T().text, font_);
@@ -1210,8 +1162,18 @@ void UI::drawSearchResultsPopup() {
     std::string title = i18n::fmt(StrKey::SearchResultsTitle, std::to_string(searchResults_.size()));
     drawTextCentered(title, popX + POP_W / 2, popY + 22, T().text, font_);
 
+    // Other banks are still being searched (the worker is joined once its
+    // last matches are merged)
+    bool searching = diskSearchWorker_.joinable();
+    if (searching) {
+        std::string progress = i18n::fmt(StrKey::SearchingProgress, std::to_string(diskSearchSeen_),
+            std::to_string(diskSearchTotal_.load(std::memory_order_relaxed)));
+        drawText(progress, popX + 20, popY + 14, T().textDim, fontSmall_);
+    }
+
     if (searchResults_.empty()) {
-        drawTextCentered(i18n::get(StrKey::NoPokemonFound), popX + POP_W / 2, popY + POP_H / 2, T().textDim, font_);
+        drawTextCentered(i18n::get(searching ? StrKey::Searching : StrKey::NoPokemonFound),
+                         popX + POP_W / 2, popY + POP_H / 2, T().textDim, font_);
     } else {
         constexpr int ROW_H = 36;
         int listY = popY + 50;
@@ -1270,7 +1232,9 @@ void UI::drawSearchResultsPopup() {
 
             // Location
             std::string loc;
-            if (isDualBankMode())
+            if (!r.bankPath.empty())
+                loc = r.bankName;
+            else if (isDualBankMode())
                 loc = (r.panel == Panel::Game ? i18n::get(StrKey::LocLeft) : i18n::get(StrKey::LocRight));
             else
                 loc = (r.panel == Panel::Game ? i18n::get(StrKey::LocSave) : i18n::get(StrKey::LocBank));
@@ -1437,10 +1401,9 @@ void UI::drawSpeciesListPicker() {
                 }
 
                 // Draw sprite (aspect-ratio preserved)
-                SDL_Texture* spr = getSprite(specId);
+                SpriteRef spr = getSprite(specId);
                 if (spr) {
-                    int texW, texH;
-                    SDL_QueryTexture(spr, nullptr, nullptr, &texW, &texH);
+                    int texW = spr.src.w, texH = spr.src.h;
                     int dstW = SPRITE_SZ, dstH = SPRITE_SZ;
                     if (texW > 0 && texH > 0 && (texW != texH)) {
                         float scale = std::min(static_cast<float>(SPRITE_SZ) / texW,
@@ -1451,7 +1414,7 @@ void UI::drawSpeciesListPicker() {
                     int sprX = cellX + 6 + (SPRITE_SZ - dstW) / 2;
                     int sprY = cellY + (cellH - dstH) / 2;
                     SDL_Rect dst = { sprX, sprY, dstW, dstH };
-                    SDL_RenderCopy(renderer_, spr, nullptr, &dst);
+                    SDL_RenderCopy(renderer_, spr.tex, &spr.src, &dst);
                 }
 
                 // Draw name (truncated if needed)
@@ -1529,7 +1492,7 @@ void UI::drawWondercardListPopup() {
                 x += 40;
 
                 // Sprite (shiny variant if wondercard is shiny)
-                SDL_Texture* sprite = nullptr;
+                SpriteRef sprite;
                 if (wc.isShiny) {
                     sprite = getShinySprite(wc.species);
                     if (!sprite) sprite = getSprite(wc.species);
@@ -1537,15 +1500,14 @@ void UI::drawWondercardListPopup() {
                     sprite = getSprite(wc.species);
                 }
                 if (sprite) {
-                    int tw = 0, th = 0;
-                    SDL_QueryTexture(sprite, nullptr, nullptr, &tw, &th);
+                    int tw = sprite.src.w, th = sprite.src.h;
                     int maxH = ROW_H - 6;
                     float scale = std::min(static_cast<float>(maxH) / tw,
                                            static_cast<float>(maxH) / th);
                     int dw = static_cast<int>(tw * scale);
                     int dh = static_cast<int>(th * scale);
                     SDL_Rect dst = {x + (maxH - dw) / 2, rowY + 2 + (maxH - dh) / 2, dw, dh};
-                    SDL_RenderCopy(renderer_, sprite, nullptr, &dst);
+                    SDL_RenderCopy(renderer_, sprite.tex, &sprite.src, &dst);
                 }
                 x += ROW_H;
 
@@ -1570,7 +1532,7 @@ void UI::drawWondercardListPopup() {
                 int maxW = listX + listW - x - 5;
                 std::string fn = wc.filename;
                 while (fn.size() > 4) {
-                    int tw = getTextEntry(fn, fontSmall_, T().textDim).w;
+                    int tw = measureText(fn, fontSmall_).w;
                     if (tw <= maxW) break;
                     fn = fn.substr(0, fn.size() - 5) + "..";
                 }
@@ -1589,7 +1551,7 @@ void UI::drawAboutPopup() {
     drawRect(0, 0, SCREEN_W, SCREEN_H, T().overlayDark);
 
     constexpr int POP_W = 700;
-    constexpr int POP_H = 510;
+    constexpr int POP_H = 530;
     int px = (SCREEN_W - POP_W) / 2;
     int py = (SCREEN_H - POP_H) / 2;
 
@@ -1648,10 +1610,74 @@ void UI::drawAboutPopup() {
     y += 20;
     drawText(i18n::get(StrKey::ControlsLine2), px + 50, y, T().textDim, fontSmall_);
 
+    // Sprite texture cache usage
+    {
+        TextureCache::Stats ts = textureCache_.stats();
+        char used[16], budget[16];
+        std::snprintf(used, sizeof(used), "%.1f", ts.bytes / 1048576.0);
+        std::snprintf(budget, sizeof(budget), "%.0f", ts.budget / 1048576.0);
+        std::string line = i18n::fmt(StrKey::TextureCacheUsage, used, budget,
+                                     std::to_string(ts.textures), std::to_string(ts.evictions));
+        drawTextCentered(line, cx, py + POP_H - 44, T().textDim, fontSmall_);
+    }
+
     // Footer
     drawTextCentered(i18n::get(StrKey::PressMinusBClose), cx, py + POP_H - 22, T().textDim, fontSmall_);
 }
 
+void UI::drawPerfOverlay() {
+    if (showPerfOverlay_) {
+        constexpr int PAD    = 8;
+        constexpr int LINE_H = 17;
+        constexpr int GRAPH_H = 40;
+        constexpr float GRAPH_MAX_MS = 50.0f;
+        constexpr int BAR_W  = 2;
+        constexpr int W = PAD * 2 + PERF_HISTORY * BAR_W;
+        constexpr int ZONES = static_cast<int>(ProfZone::Count);
+        constexpr int H = PAD * 3 + LINE_H * (ZONES + 1) + GRAPH_H;
+        int x = SCREEN_W - W - 10;
+        int y = 10;
+        drawRect(x, y, W, H, T().overlayDark);
+
+        // Stats are for the previous frame; this one is still being built
+        Profiler::FrameStats fs = Profiler::lastFrame();
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "frame %.1f ms (%.0f fps)", fs.frameMs,
+                      fs.frameMs > 0 ? 1000.0 / fs.frameMs : 0.0);
+        drawText(buf, x + PAD, y + PAD, T().text, fontSmall_);
+
+        int ly = y + PAD + LINE_H;
+        for (int z = 0; z < ZONES; z++, ly += LINE_H) {
+            SDL_Color c = fs.calls[z] ? T().text : T().textDim;
+            drawText(Profiler::zoneName(static_cast<ProfZone>(z)), x + PAD, ly, c, fontSmall_);
+            std::snprintf(buf, sizeof(buf), "%6.2f ms  x%u", fs.zoneMs[z],
+                          static_cast<unsigned>(fs.calls[z]));
+            drawText(buf, x + PAD + 120, ly, c, fontSmall_);
+        }
+
+        // Frame-time history, oldest on the left; the line marks 60 fps
+        int gy = ly + PAD;
+        drawRect(x + PAD, gy, PERF_HISTORY * BAR_W, GRAPH_H, T().panelBg);
+        for (int i = 0; i < PERF_HISTORY; i++) {
+            float ms = perfHistory_[(perfHistoryPos_ + i) % PERF_HISTORY];
+            int h = static_cast<int>(GRAPH_H * std::min(ms / GRAPH_MAX_MS, 1.0f));
+            if (h > 0)
+                drawRect(x + PAD + i * BAR_W, gy + GRAPH_H - h, BAR_W, h,
+                         ms > 34.0f ? T().red : T().arrow);
+        }
+        int mark = gy + GRAPH_H - static_cast<int>(GRAPH_H * (16.7f / GRAPH_MAX_MS));
+        drawRect(x + PAD, mark, PERF_HISTORY * BAR_W, 1, T().textDim);
+    }
+
+    if (!perfNotice_.empty()) {
+        TextExtent e = measureText(perfNotice_, fontSmall_);
+        int w = e.w + 24;
+        int y = SCREEN_H - 35 - 40;
+        drawRect((SCREEN_W - w) / 2, y, w, 30, T().overlayDark);
+        drawTextCentered(perfNotice_, SCREEN_W / 2, y + 15, T().text, fontSmall_);
+    }
+}
+
 void UI::drawBoxViewOverlay() {
     // Full-screen dark overlay
     drawRect(0, 0, SCREEN_W, SCREEN_H, T().overlay);
@@ -1835,7 +1861,7 @@ void UI::drawBoxPreview(int boxIdx, int anchorX, int anchorY) {
             } else {
                 drawRect(sx, sy, BV_MINI_CELL, BV_MINI_CELL, T().miniCellFull);
 
-                SDL_Texture* sprite = nullptr;
+                SpriteRef sprite;
                 if (psd.egg) {
                     sprite = getSprite(0);
                 } else if (psd.shiny) {
@@ -1845,8 +1871,7 @@ void UI::drawBoxPreview(int boxIdx, int anchorX, int anchorY) {
                     sprite = getSprite(psd.species, psd.form);
                 }
                 if (sprite) {
-                    int texW, texH;
-                    SDL_QueryTexture(sprite, nullptr, nullptr, &texW, &texH);
+                    int texW = sprite.src.w, texH = sprite.src.h;
                     float scale = std::min(float(BV_MINI_SPRITE) / texW,
                                            float(BV_MINI_SPRITE) / texH);
                     int dstW = static_cast<int>(texW * scale);
@@ -1856,7 +1881,7 @@ void UI::drawBoxPreview(int boxIdx, int anchorX, int anchorY) {
                         sy + (BV_MINI_CELL - dstH) / 2,
                         dstW, dstH
                     };
-                    SDL_RenderCopy(renderer_, sprite, nullptr, &dst);
+                    SDL_RenderCopy(renderer_, sprite.tex, &sprite.src, &dst);
                 }
 
                 // Search highlight on mini slots
@@ -1882,7 +1907,7 @@ void UI::drawHeldOverlay() {
         return;
 
     uint8_t heldForm = pkm.form();
-    SDL_Texture* sprite = nullptr;
+    SpriteRef sprite;
     if (pkm.isEgg()) {
         sprite = getSprite(0);
     } else if (pkm.isShiny()) {
@@ -1908,8 +1933,7 @@ void UI::drawHeldOverlay() {
     int baseY = cellY + DRAG_OFS;
 
     // Scale sprite to fit SPRITE_SIZE
-    int texW, texH;
-    SDL_QueryTexture(sprite, nullptr, nullptr, &texW, &texH);
+    int texW = sprite.src.w, texH = sprite.src.h;
     int dstW = SPRITE_SIZE, dstH = SPRITE_SIZE;
     if (texW > 0 && texH > 0) {
         float scale = std::min(static_cast<float>(SPRITE_SIZE) / texW,
@@ -1922,15 +1946,15 @@ void UI::drawHeldOverlay() {
     int sprY = baseY + 4 + (SPRITE_SIZE - dstH) / 2;
 
     // Draw semi-transparent
-    SDL_SetTextureAlphaMod(sprite, 180);
+    SDL_SetTextureAlphaMod(sprite.tex, 180);
     SDL_Rect dst = {sprX, sprY, dstW, dstH};
-    SDL_RenderCopy(renderer_, sprite, nullptr, &dst);
-    SDL_SetTextureAlphaMod(sprite, 255);
+    SDL_RenderCopy(renderer_, sprite.tex, &sprite.src, &dst);
+    SDL_SetTextureAlphaMod(sprite.tex, 255);
 
     // Multi-hold: draw count badge
     if (!heldMulti_.empty() && heldMulti_.size() > 1) {
         std::string num = std::to_string(heldMulti_.size());
-        auto& numE = getTextEntry(num, font_, T().textOnBadge);
+        TextExtent numE = measureText(num, font_);
         int tw = numE.w, th = numE.h;
         int badgeR = std::max(tw, th) / 2 + 6;
         int cx = cellX + CELL_W / 2;
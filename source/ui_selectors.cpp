@@ -8,20 +8,71 @@
 #include <switch.h>
 
 void UI::refreshBankCounts() {
+    stopBankCountScan();
+    bankCountResults_.clear();  // worker is joined, nothing else touches it
     gameBankCounts_.clear();
+    startBankCountScan();
+}
+
+void UI::recountBanks(GameType game) {
+    stopBankCountScan();
+    collectBankCounts();
+    gameBankCounts_.erase(game);
+    gameBankCounts_.erase(pairedGame(game));
+    startBankCountScan();
+}
+
+void UI::startBankCountScan() {
+    // Paired games share a bank folder, so each folder is counted once
+    std::vector<GameType> pending;
     for (GameType g : availableGames_) {
-        GameType p = pairedGame(g);
-        auto it = gameBankCounts_.find(p);
-        if (it != gameBankCounts_.end())
-            gameBankCounts_[g] = it->second;
-        else
-            gameBankCounts_[g] = BankManager::countBanks(basePath_, g);
+        if (gameBankCounts_.count(g))
+            continue;
+        if (std::find(pending.begin(), pending.end(), pairedGame(g)) == pending.end())
+            pending.push_back(g);
+    }
+    if (pending.empty())
+        return;
+
+    bankCountCancel_.store(false, std::memory_order_relaxed);
+    bankCountWorker_ = std::thread([this, pending = std::move(pending),
+                                    basePath = basePath_] {
+        for (GameType g : pending) {
+            if (bankCountCancel_.load(std::memory_order_relaxed))
+                break;
+            int cnt = BankManager::countBanks(basePath, g);
+            std::lock_guard<std::mutex> lock(bankCountMutex_);
+            bankCountResults_.emplace_back(g, cnt);
+        }
+    });
+}
+
+void UI::stopBankCountScan() {
+    if (!bankCountWorker_.joinable())
+        return;
+    bankCountCancel_.store(true, std::memory_order_relaxed);
+    bankCountWorker_.join();
+}
+
+bool UI::collectBankCounts() {
+    std::vector<std::pair<GameType, int>> results;
+    {
+        std::lock_guard<std::mutex> lock(bankCountMutex_);
+        if (bankCountResults_.empty())
+            return false;
+        results.swap(bankCountResults_);
+    }
+    for (const auto& [g, cnt] : results) {
+        gameBankCounts_[g] = cnt;
+        gameBankCounts_[pairedGame(g)] = cnt;
     }
+    return true;
 }
 
 // --- Profile Selector ---
 
 void UI::drawProfileSelectorFrame() {
+    Profiler::Scope probe(ProfZone::Draw);
     SDL_SetRenderDrawColor(renderer_, T().bg.r, T().bg.g, T().bg.b, 255);
     SDL_RenderClear(renderer_);
 
@@ -252,6 +303,7 @@ void UI::freeGameIcons() {
 // --- Game Selector ---
 
 void UI::drawGameSelectorFrame() {
+    Profiler::Scope probe(ProfZone::Draw);
     SDL_SetRenderDrawColor(renderer_, T().bg.r, T().bg.g, T().bg.b, 255);
     SDL_RenderClear(renderer_);
 
@@ -341,10 +393,10 @@ void UI::drawGameSelectorFrame() {
         drawTextCentered(name, cardX + CARD_W / 2, cardY + ICON_SIZE + 30,
                          T().text, fontSmall_);
 
-        // Bank count under game name
+        // Bank count under game name; "(...)" until the worker reports it
         auto bc = gameBankCounts_.find(availableGames_[i]);
-        int bankCount = (bc != gameBankCounts_.end()) ? bc->second : 0;
-        std::string bankStr = "(" + std::to_string(bankCount) + ")";
+        std::string bankStr = (bc != gameBankCounts_.end())
+            ? "(" + std::to_string(bc->second) + ")" : "(...)";
         drawTextCentered(bankStr, cardX + CARD_W / 2, cardY + ICON_SIZE + 50,
                          T().textDim, fontSmall_);
     }
@@ -356,7 +408,7 @@ void UI::drawGameSelectorFrame() {
         int allBanksY = gridBottomY + 10;
 
         std::string label = i18n::get(StrKey::ViewAllBanks);
-        const auto& te = getTextEntry(label, font_, T().text);
+        TextExtent te = measureText(label, font_);
         int labelW = te.w + 40;  // padding
         int labelH = 36;
         int labelX = (SCREEN_W - labelW) / 2;
@@ -402,16 +454,16 @@ void UI::drawGameSelectorFrame() {
         drawStatusBar(totalPages > 1 ? i18n::get(StrKey::StatusGameBackPage)
                                      : i18n::get(StrKey::StatusGameBack));
         std::string profileLabel = account_.profiles()[selectedProfile_].nickname;
-        const auto& e = getTextEntry(profileLabel, fontSmall_, T().goldLabel);
-        if (e.tex) drawText(profileLabel, SCREEN_W - e.w - 15, SCREEN_H - 26, T().goldLabel, fontSmall_);
+        TextExtent e = measureText(profileLabel, fontSmall_);
+        if (e.w > 0) drawText(profileLabel, SCREEN_W - e.w - 15, SCREEN_H - 26, T().goldLabel, fontSmall_);
     } else {
         drawStatusBar(totalPages > 1 ? i18n::get(StrKey::StatusGameQuitPage)
                                      : i18n::get(StrKey::StatusGameQuit));
     }
     if (appletMode_) {
         std::string modeLabel = i18n::get(StrKey::DualBankMode);
-        const auto& e = getTextEntry(modeLabel, fontSmall_, T().goldLabel);
-        if (e.tex) drawText(modeLabel, SCREEN_W - e.w - 15, SCREEN_H - 26, T().goldLabel, fontSmall_);
+        TextExtent e = measureText(modeLabel, fontSmall_);
+        if (e.w > 0) drawText(modeLabel, SCREEN_W - e.w - 15, SCREEN_H - 26, T().goldLabel, fontSmall_);
     }
 }
 
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Pack a directory of Pokemon sprite PNGs into a pre-decoded sprite atlas.
+
+Usage:
+    python3 pack_sprite_atlas.py <sprite_dir> <out.atlas>
+
+Reads every NNN.png / NNN-F.png (national dex ID, optional form) in
+<sprite_dir>, shelf-packs them into RGBA8 pages of at most 1024x1024 and
+writes one file the UI uploads straight to textures, with no PNG decode
+at runtime. The Makefile runs this for romfs/sprites and
+romfs/sprites_shiny before the romfs is packed.
+
+File layout (little-endian, read by source/sprite_atlas.cpp):
+    header   "PKAT", u16 version, u16 pageCount, u32 entryCount
+    pages    pageCount x { u16 w, u16 h, u32 dataOffset }
+    entries  entryCount x { u16 species, u8 form, u8 page,
+                            u16 x, u16 y, u16 w, u16 h }, sorted by (species, form)
+    data     one RGBA8 row-major block per page, straight alpha
+
+Only needs the Python standard library.
+"""
+import os
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = b'PKAT'
+VERSION = 1
+PAGE_W = 1024
+PAGE_H = 1024
+PAD = 1  # transparent gutter so scaled sprites don't bleed into neighbours
+
+NAME_RE = re.compile(r'^(\d+)(?:-(\d+))?\.png$')
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def decode_png(path):
+    """Decode an 8-bit RGBA, non-interlaced PNG to (w, h, bytearray)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s: not a PNG' % path)
+    pos, idat = 8, []
+    w = h = 0
+    while pos < len(data):
+        length, ctype = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if ctype == b'IHDR':
+            w, h, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', body)
+            if depth != 8 or color != 6 or interlace != 0:
+                raise ValueError('%s: expected 8-bit RGBA, non-interlaced' % path)
+        elif ctype == b'IDAT':
+            idat.append(body)
+        elif ctype == b'IEND':
+            break
+        pos += 12 + length
+
+    raw = zlib.decompress(b''.join(idat))
+    stride = w * 4
+    out = bytearray(stride * h)
+    prev = bytearray(stride)
+    for y in range(h):
+        ftype = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        if ftype == 1:
+            for i in range(4, stride):
+                line[i] = (line[i] + line[i - 4]) & 0xFF
+        elif ftype == 2:
+            for i in range(stride):
+                line[i] = (line[i] + prev[i]) & 0xFF
+        elif ftype == 3:
+            for i in range(stride):
+                left = line[i - 4] if i >= 4 else 0
+                line[i] = (line[i] + ((left + prev[i]) >> 1)) & 0xFF
+        elif ftype == 4:
+            for i in range(stride):
+                left = line[i - 4] if i >= 4 else 0
+                upleft = prev[i - 4] if i >= 4 else 0
+                line[i] = (line[i] + paeth(left, prev[i], upleft)) & 0xFF
+        out[y * stride:(y + 1) * stride] = line
+        prev = line
+    return w, h, out
+
+
+def load_sprites(src):
+    sprites = []
+    for name in sorted(os.listdir(src)):
+        m = NAME_RE.match(name)
+        if not m:
+            continue
+        species, form = int(m.group(1)), int(m.group(2) or 0)
+        if species > 0xFFFF or form > 0xFF:
+            continue
+        w, h, px = decode_png(os.path.join(src, name))
+        sprites.append({'species': species, 'form': form, 'w': w, 'h': h, 'px': px})
+    return sprites
+
+
+def pack(sprites):
+    """Shelf packing, tallest first. Returns page sizes; sets page/x/y."""
+    pages = []  # [used_h]
+    x = y = shelf_h = 0
+    for s in sorted(sprites, key=lambda s: (-s['h'], -s['w'])):
+        w, h = s['w'] + PAD, s['h'] + PAD
+        if not pages:
+            pages.append(0)
+        if x + w > PAGE_W:
+            x, y, shelf_h = 0, y + shelf_h, 0
+        if y + h > PAGE_H:
+            pages.append(0)
+            x = y = shelf_h = 0
+        s['page'], s['x'], s['y'] = len(pages) - 1, x, y
+        x += w
+        shelf_h = max(shelf_h, h)
+        pages[-1] = max(pages[-1], y + shelf_h)
+    return [(PAGE_W, used) for used in pages]
+
+
+def write_atlas(sprites, pages, out):
+    bitmaps = [bytearray(w * h * 4) for w, h in pages]
+    for s in sprites:
+        pw = pages[s['page']][0]
+        dst = bitmaps[s['page']]
+        row = s['w'] * 4
+        for r in range(s['h']):
+            o = ((s['y'] + r) * pw + s['x']) * 4
+            dst[o:o + row] = s['px'][r * row:(r + 1) * row]
+
+    header = struct.pack('<4sHHI', MAGIC, VERSION, len(pages), len(sprites))
+    offset = len(header) + len(pages) * 8 + len(sprites) * 12
+    table = b''
+    for (w, h), bmp in zip(pages, bitmaps):
+        table += struct.pack('<HHI', w, h, offset)
+        offset += len(bmp)
+    entries = b''.join(
+        struct.pack('<HBBHHHH', s['species'], s['form'], s['page'],
+                    s['x'], s['y'], s['w'], s['h'])
+        for s in sorted(sprites, key=lambda s: (s['species'], s['form'])))
+
+    os.makedirs(os.path.dirname(os.path.abspath(out)), exist_ok=True)
+    with open(out, 'wb') as f:
+        f.write(header + table + entries)
+        for bmp in bitmaps:
+            f.write(bmp)
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+    src, out = sys.argv[1], sys.argv[2]
+    sprites = load_sprites(src)
+    if not sprites:
+        print('no sprites found in', src)
+        sys.exit(1)
+    pages = pack(sprites)
+    write_atlas(sprites, pages, out)
+    print('packed %d sprites from %s into %d page(s) -> %s'
+          % (len(sprites), src, len(pages), out))
+
+
+if __name__ == '__main__':
+    main()